@@ -0,0 +1,147 @@
+// Microbenchmark das primitivas do display: compara as cópias por bytes de lib/ssd1306.c com o
+// caminho antigo pixel a pixel (ssd1306_pixel em laço) e mede o envio das diferenças (janelas
+// alteradas montadas e entregues ao painel virtual pela HAL falsa). Confere também que os dois
+// caminhos deixam o buffer idêntico.
+//   bench_ssd1306 [iteracoes]
+
+#include "ssd1306.h"
+#include "hal_fake.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BENCH_ITERATIONS 20000
+
+static ssd1306_t ssd;
+static volatile uint32_t sink; // Impede que o compilador descarte os laços
+
+// Caminho antigo: um ssd1306_pixel (índice + leitura-modificação-escrita) por pixel
+static void ref_fill(ssd1306_t *s, bool value) {
+  for (uint8_t y = 0; y < s->height; ++y)
+    for (uint8_t x = 0; x < s->width; ++x)
+      ssd1306_pixel(s, x, y, value);
+}
+
+static void ref_hline(ssd1306_t *s, uint8_t x0, uint8_t x1, uint8_t y, bool value) {
+  for (uint8_t x = x0; x <= x1; ++x)
+    ssd1306_pixel(s, x, y, value);
+}
+
+static void ref_vline(ssd1306_t *s, uint8_t x, uint8_t y0, uint8_t y1, bool value) {
+  for (uint8_t y = y0; y <= y1; ++y)
+    ssd1306_pixel(s, x, y, value);
+}
+
+static void ref_rect(ssd1306_t *s, uint8_t top, uint8_t left, uint8_t width, uint8_t height, bool value, bool fill) {
+  for (uint8_t x = left; x < left + width; ++x) {
+    ssd1306_pixel(s, x, top, value);
+    ssd1306_pixel(s, x, top + height - 1, value);
+  }
+  for (uint8_t y = top; y < top + height; ++y) {
+    ssd1306_pixel(s, left, y, value);
+    ssd1306_pixel(s, left + width - 1, y, value);
+  }
+  if (fill) {
+    for (uint8_t x = left + 1; x < left + width - 1; ++x)
+      for (uint8_t y = top + 1; y < top + height - 1; ++y)
+        ssd1306_pixel(s, x, y, value);
+  }
+}
+
+typedef enum { PRIM_FILL, PRIM_RECT, PRIM_HLINE, PRIM_VLINE, PRIM_COUNT } primitive_t;
+
+static const char *const names[PRIM_COUNT] = { "fill", "rect 118x19 cheio", "hline 121 px", "vline 26 px" };
+
+static void draw(primitive_t p, bool reference, bool value) {
+  switch (p) {
+    case PRIM_FILL:
+      reference ? ref_fill(&ssd, value) : ssd1306_fill(&ssd, value);
+      break;
+    case PRIM_RECT:
+      reference ? ref_rect(&ssd, 22, 5, 118, 19, value, true) : ssd1306_rect(&ssd, 22, 5, 118, 19, value, true);
+      break;
+    case PRIM_HLINE:
+      reference ? ref_hline(&ssd, 3, 123, 37, value) : ssd1306_hline(&ssd, 3, 123, 37, value);
+      break;
+    default:
+      reference ? ref_vline(&ssd, 64, 5, 30, value) : ssd1306_vline(&ssd, 64, 5, 30, value);
+      break;
+  }
+  sink += ssd.ram_buffer[1 + (sink & 0x3FF)];
+}
+
+// Tempo médio (ns) de uma chamada, alternando a cor para que cada uma altere o buffer
+static double measure(primitive_t p, bool reference, uint32_t iterations) {
+  uint64_t start_us = hal_time_us();
+  for (uint32_t i = 0; i < iterations; i++)
+    draw(p, reference, i & 1);
+  return (hal_time_us() - start_us) * 1000.0 / iterations;
+}
+
+// Mesmo resultado nos dois caminhos, partindo de um fundo com padrão
+static bool same_result(primitive_t p) {
+  uint8_t expected[WIDTH * HEIGHT / 8 + 1];
+
+  for (int value = 0; value < 2; value++) {
+    for (size_t i = 1; i < ssd.bufsize; i++)
+      ssd.ram_buffer[i] = (uint8_t)(i * 37);
+    draw(p, true, value);
+    memcpy(expected, ssd.ram_buffer, ssd.bufsize);
+
+    for (size_t i = 1; i < ssd.bufsize; i++)
+      ssd.ram_buffer[i] = (uint8_t)(i * 37);
+    draw(p, false, value);
+    if (memcmp(expected, ssd.ram_buffer, ssd.bufsize) != 0)
+      return false;
+  }
+  return true;
+}
+
+// Envio assíncrono: diferença contra o último quadro, montagem das palavras e entrega ao painel
+static double measure_flush(uint32_t iterations, bool full, uint32_t *bus_bytes) {
+  vssd1306_t *panel = hal_fake_panel();
+  uint32_t bytes_before = panel->bytes;
+  uint64_t start_us = hal_time_us();
+
+  for (uint32_t i = 0; i < iterations; i++) {
+    if (full)
+      ssd1306_fill(&ssd, i & 1);
+    else
+      ssd1306_rect(&ssd, 40, 100, 8, 8, i & 1, true); // Um campo pequeno, como o contador
+    if (ssd1306_send_data_async(&ssd, NULL, NULL))
+      hal_fake_stream_complete();
+  }
+
+  *bus_bytes = (panel->bytes - bytes_before) / iterations;
+  return (hal_time_us() - start_us) * 1000.0 / iterations;
+}
+
+int main(int argc, char **argv) {
+  uint32_t iterations = argc > 1 ? strtoul(argv[1], NULL, 10) : BENCH_ITERATIONS;
+  bool ok = true;
+
+  hal_fake_init();
+  ssd1306_init(&ssd, WIDTH, HEIGHT, false, HAL_FAKE_PANEL_ADDRESS, 0);
+  ssd1306_config(&ssd);
+
+  printf("%-20s %12s %12s %9s\n", "primitiva", "pixel (ns)", "bytes (ns)", "ganho");
+  for (primitive_t p = 0; p < PRIM_COUNT; p++) {
+    bool same = same_result(p);
+    ok = ok && same;
+
+    // O fill pixel a pixel é lento: menos iterações mantêm o tempo total razoável
+    uint32_t n = p == PRIM_FILL ? iterations / 20 + 1 : iterations;
+    double ref_ns = measure(p, true, n);
+    double blit_ns = measure(p, false, n);
+    printf("%-20s %12.1f %12.1f %8.1fx%s\n", names[p], ref_ns, blit_ns, blit_ns > 0 ? ref_ns / blit_ns : 0.0,
+           same ? "" : "  DIFERENTE");
+  }
+
+  uint32_t small_bytes, full_bytes;
+  double small_ns = measure_flush(iterations, false, &small_bytes);
+  double full_ns = measure_flush(iterations / 20 + 1, true, &full_bytes);
+  printf("envio de um campo 8x8:  %10.1f ns, %u bytes no barramento\n", small_ns, small_bytes);
+  printf("envio da tela inteira:  %10.1f ns, %u bytes no barramento\n", full_ns, full_bytes);
+
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,185 @@
+#include "hal_fake.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define FAKE_MAX_STREAMS 4
+
+// Transferência assíncrona aguardando a conclusão pedida pelo teste
+typedef struct {
+  bool pending;
+  uint8_t address;
+  const uint16_t *words;
+  size_t count;
+  hal_i2c_stream_done_t done;
+  void *ctx;
+  uint32_t order; // Ordem de início, para concluir da mais antiga para a mais nova
+  bool finished;  // Término ainda não consumido por hal_i2c_stream_wait (semáforo binário)
+} fake_stream_t;
+
+static vssd1306_t panel;
+static vflash_t flash;
+static struct timespec boot_time;
+
+static fake_stream_t streams[FAKE_MAX_STREAMS];
+static uint8_t stream_count = 0;
+static pthread_mutex_t stream_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t stream_finished = PTHREAD_COND_INITIALIZER;
+static volatile uint32_t stream_starts = 0, wait_idle_calls = 0;
+
+static hal_fake_sink_t telemetry_sink;
+static void *telemetry_ctx;
+
+void hal_fake_init(void) {
+  clock_gettime(CLOCK_MONOTONIC, &boot_time);
+  vssd1306_init(&panel, HAL_FAKE_PANEL_ADDRESS);
+  vflash_init(&flash, NULL);
+  stream_count = 0;
+  stream_starts = 0;
+  wait_idle_calls = 0;
+  telemetry_sink = NULL;
+}
+
+void hal_panic(const char *message) {
+  fprintf(stderr, "panic: %s\n", message);
+  exit(1);
+}
+
+uint64_t hal_time_us(void) {
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (uint64_t)(now.tv_sec - boot_time.tv_sec) * 1000000u + (now.tv_nsec - boot_time.tv_nsec) / 1000;
+}
+
+uint32_t hal_time_ms(void) {
+  return (uint32_t)(hal_time_us() / 1000u);
+}
+
+uint32_t hal_time_us32(void) {
+  return (uint32_t)hal_time_us();
+}
+
+int hal_i2c_write(hal_i2c_t port, uint8_t address, const uint8_t *src, size_t len) {
+  if (address != panel.address)
+    return -1;
+
+  vssd1306_write(&panel, src, len);
+  return (int)len;
+}
+
+void hal_i2c_wait_idle(hal_i2c_t port) {
+  wait_idle_calls++;
+}
+
+int hal_i2c_stream_claim(hal_i2c_t port) {
+  if (stream_count == FAKE_MAX_STREAMS)
+    hal_panic("Sem fluxos I2C disponíveis");
+
+  streams[stream_count].pending = false;
+  streams[stream_count].finished = false;
+  return stream_count++;
+}
+
+// O canal de DMA só pode ser reprogramado depois da conclusão da transferência anterior
+void hal_i2c_stream_start(int stream, uint8_t address, const uint16_t *words, size_t count,
+                          hal_i2c_stream_done_t done, void *ctx) {
+  fake_stream_t *s = &streams[stream];
+  if (s->pending)
+    hal_panic("Fluxo I2C reiniciado antes de concluir");
+
+  s->address = address;
+  s->words = words;
+  s->count = count;
+  s->done = done;
+  s->ctx = ctx;
+  s->order = stream_starts++;
+  s->pending = true;
+}
+
+uint32_t hal_fake_stream_pending(void) {
+  uint32_t pending = 0;
+  for (uint8_t i = 0; i < stream_count; i++)
+    pending += streams[i].pending;
+  return pending;
+}
+
+bool hal_fake_stream_complete(void) {
+  fake_stream_t *oldest = NULL;
+  for (uint8_t i = 0; i < stream_count; i++) {
+    if (streams[i].pending && (!oldest || (int32_t)(streams[i].order - oldest->order) < 0))
+      oldest = &streams[i];
+  }
+  if (!oldest)
+    return false;
+
+  // Divide as transações nos bits de STOP, como o controlador I2C
+  static uint8_t transaction[2048];
+  size_t len = 0;
+  for (size_t i = 0; i < oldest->count; ++i) {
+    if (len < sizeof(transaction))
+      transaction[len++] = oldest->words[i] & 0xFF;
+
+    if (oldest->words[i] & HAL_I2C_STOP) {
+      hal_i2c_write(0, oldest->address, transaction, len);
+      len = 0;
+    }
+  }
+
+  oldest->pending = false;
+  if (oldest->done)
+    oldest->done(oldest->ctx);
+
+  // Como a interrupção real: o término é sinalizado depois de 'done'
+  pthread_mutex_lock(&stream_lock);
+  oldest->finished = true;
+  pthread_cond_broadcast(&stream_finished);
+  pthread_mutex_unlock(&stream_lock);
+  return true;
+}
+
+void hal_i2c_stream_wait(int stream) {
+  pthread_mutex_lock(&stream_lock);
+  while (!streams[stream].finished)
+    pthread_cond_wait(&stream_finished, &stream_lock);
+  streams[stream].finished = false;
+  pthread_mutex_unlock(&stream_lock);
+}
+
+uint32_t hal_fake_stream_starts(void) {
+  return stream_starts;
+}
+
+uint32_t hal_fake_wait_idle_calls(void) {
+  return wait_idle_calls;
+}
+
+void hal_flash_read(uint32_t offset, void *dst, size_t len) {
+  vflash_read(&flash, offset, dst, len);
+}
+
+void hal_flash_erase(uint32_t offset) {
+  vflash_erase(&flash, offset);
+}
+
+void hal_flash_program(uint32_t offset, const void *src, size_t len) {
+  vflash_program(&flash, offset, src, len);
+}
+
+void hal_fake_telemetry_sink(hal_fake_sink_t sink, void *ctx) {
+  telemetry_sink = sink;
+  telemetry_ctx = ctx;
+}
+
+void hal_telemetry_write(const uint8_t *data, size_t len) {
+  if (telemetry_sink)
+    telemetry_sink(data, len, telemetry_ctx);
+}
+
+vssd1306_t *hal_fake_panel(void) {
+  return &panel;
+}
+
+vflash_t *hal_fake_flash(void) {
+  return &flash;
+}
@@ -0,0 +1,35 @@
+#ifndef HAL_FAKE_H
+#define HAL_FAKE_H
+
+// HAL dos testes da simulação: tempo real, flash virtual apenas em RAM e I2C ligado a um
+// SSD1306 virtual. O fluxo I2C assíncrono não termina sozinho: a transferência fica pendente
+// até o teste chamar hal_fake_stream_complete, que faz o papel da interrupção do DMA.
+
+#include "hal.h"
+#include "virtual_ssd1306.h"
+#include "virtual_flash.h"
+
+#define HAL_FAKE_PANEL_ADDRESS 0x3C
+
+typedef void (*hal_fake_sink_t)(const uint8_t *data, size_t len, void *ctx);
+
+void hal_fake_init(void);
+
+vssd1306_t *hal_fake_panel(void);
+vflash_t *hal_fake_flash(void);
+
+// Transferências iniciadas e ainda não concluídas (no máximo uma por fluxo)
+uint32_t hal_fake_stream_pending(void);
+
+// Conclui a transferência pendente mais antiga: entrega as palavras ao painel (lidas só agora,
+// como o DMA faria) e chama 'done'. Retorna false se não houver transferência pendente.
+bool hal_fake_stream_complete(void);
+
+// Fluxos iniciados desde hal_fake_init e chamadas de hal_i2c_wait_idle
+uint32_t hal_fake_stream_starts(void);
+uint32_t hal_fake_wait_idle_calls(void);
+
+// Destino dos bytes de hal_telemetry_write (descartados se não houver)
+void hal_fake_telemetry_sink(hal_fake_sink_t sink, void *ctx);
+
+#endif
@@ -0,0 +1,295 @@
+#include "hal_host.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define HOST_PANEL_ADDRESS 0x3C
+#define HOST_MAX_STREAMS 4
+#define HOST_FLASH_FILE "parking_flash.bin"
+#define HOST_TELEMETRY_FILE "parking_telemetry.bin"
+#define HOST_CONSOLE_SIZE 256
+
+// Estado simulado dos pinos
+static bool gpio_level[HAL_HOST_GPIO_COUNT];
+static uint32_t gpio_irq_events[HAL_HOST_GPIO_COUNT];
+static uint32_t gpio_irq_enabled[HAL_HOST_GPIO_COUNT];
+static hal_gpio_irq_t gpio_irq_callback;
+
+// Estado simulado do PWM (apenas registrado)
+static uint32_t pwm_wrap[HAL_HOST_GPIO_COUNT];
+static bool pwm_enabled[HAL_HOST_GPIO_COUNT];
+
+static vssd1306_t panel;
+static vflash_t flash;
+static uint8_t stream_count = 0;
+static hal_i2c_t stream_port[HOST_MAX_STREAMS];
+
+static struct timespec boot_time;
+static FILE *telemetry_file;
+
+// Caracteres enviados ao console da aplicação pelo comando 'console'
+static char console_buffer[HOST_CONSOLE_SIZE];
+static volatile uint32_t console_head = 0, console_tail = 0;
+
+static void vHostInputTask(void *params);
+static StackType_t input_task_stack[configMINIMAL_STACK_SIZE];
+static StaticTask_t input_task_tcb;
+
+void hal_init(void) {
+  clock_gettime(CLOCK_MONOTONIC, &boot_time);
+  vssd1306_init(&panel, HOST_PANEL_ADDRESS);
+
+  const char *flash_file = getenv("PARKING_SIM_FLASH");
+  vflash_init(&flash, flash_file ? flash_file : HOST_FLASH_FILE);
+
+  // A telemetria vai para um arquivo, deixando a saída padrão para o texto do console
+  const char *telemetry_name = getenv("PARKING_SIM_TELEMETRY");
+  telemetry_file = fopen(telemetry_name ? telemetry_name : HOST_TELEMETRY_FILE, "wb");
+
+  // Tarefa que lê comandos da entrada padrão e simula as bordas dos botões
+  xTaskCreateStatic(vHostInputTask, "Sim: Entrada", configMINIMAL_STACK_SIZE, NULL, configMAX_PRIORITIES - 2,
+                    input_task_stack, &input_task_tcb);
+}
+
+void hal_panic(const char *message) {
+  fprintf(stderr, "panic: %s\n", message);
+  exit(1);
+}
+
+uint64_t hal_time_us(void) {
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (uint64_t)(now.tv_sec - boot_time.tv_sec) * 1000000u +
+         (now.tv_nsec - boot_time.tv_nsec) / 1000;
+}
+
+uint32_t hal_time_ms(void) {
+  return (uint32_t)(hal_time_us() / 1000u);
+}
+
+uint32_t hal_time_us32(void) {
+  return (uint32_t)hal_time_us();
+}
+
+int hal_console_getchar(void) {
+  if (console_tail == console_head)
+    return -1;
+  return (unsigned char)console_buffer[console_tail++ % HOST_CONSOLE_SIZE];
+}
+
+void hal_telemetry_write(const uint8_t *data, size_t len) {
+  if (telemetry_file)
+    fwrite(data, 1, len, telemetry_file);
+}
+
+// Entrega o texto ao console da aplicação, terminado por uma quebra de linha
+static void host_console_write(const char *text) {
+  for (; *text != '\0'; ++text) {
+    if (console_head - console_tail < HOST_CONSOLE_SIZE)
+      console_buffer[console_head++ % HOST_CONSOLE_SIZE] = *text;
+  }
+  if (console_head - console_tail < HOST_CONSOLE_SIZE)
+    console_buffer[console_head++ % HOST_CONSOLE_SIZE] = '\n';
+}
+
+void hal_gpio_input_pullup(uint gpio) {
+  gpio_level[gpio] = true;
+}
+
+void hal_gpio_output(uint gpio) {
+  gpio_level[gpio] = false;
+}
+
+void hal_gpio_put(uint gpio, bool value) {
+  gpio_level[gpio] = value;
+}
+
+bool hal_gpio_get(uint gpio) {
+  return gpio_level[gpio];
+}
+
+void hal_gpio_irq_enable(uint gpio, uint32_t events, hal_gpio_irq_t callback) {
+  gpio_irq_events[gpio] |= events;
+  gpio_irq_enabled[gpio] |= events;
+  gpio_irq_callback = callback;
+}
+
+void hal_gpio_irq_set_enabled(uint gpio, uint32_t events, bool enabled) {
+  if (enabled)
+    gpio_irq_enabled[gpio] |= events & gpio_irq_events[gpio];
+  else
+    gpio_irq_enabled[gpio] &= ~events;
+}
+
+void hal_host_inject_gpio(uint gpio, uint32_t events) {
+  if (gpio >= HAL_HOST_GPIO_COUNT)
+    return;
+
+  gpio_level[gpio] = (events & HAL_GPIO_EDGE_RISE) != 0;
+  if ((gpio_irq_enabled[gpio] & events) && gpio_irq_callback != NULL)
+    gpio_irq_callback(gpio, events & gpio_irq_enabled[gpio]);
+}
+
+bool hal_host_gpio_level(uint gpio) {
+  return gpio < HAL_HOST_GPIO_COUNT && gpio_level[gpio];
+}
+
+void hal_pwm_init(uint gpio) {
+  pwm_enabled[gpio] = false;
+}
+
+void hal_pwm_config(uint gpio, uint32_t divider, uint32_t wrap, uint32_t level) {
+  pwm_wrap[gpio] = wrap;
+}
+
+void hal_pwm_enable(uint gpio, bool enabled) {
+  pwm_enabled[gpio] = enabled;
+}
+
+void hal_i2c_init(hal_i2c_t port, uint baudrate, uint sda, uint scl) {
+}
+
+int hal_i2c_write(hal_i2c_t port, uint8_t address, const uint8_t *src, size_t len) {
+  if (address != panel.address)
+    return -1;
+
+  vssd1306_write(&panel, src, len);
+  return (int)len;
+}
+
+void hal_i2c_wait_idle(hal_i2c_t port) {
+}
+
+int hal_i2c_stream_claim(hal_i2c_t port) {
+  if (stream_count == HOST_MAX_STREAMS)
+    hal_panic("Sem fluxos I2C disponíveis");
+
+  stream_port[stream_count] = port;
+  return stream_count++;
+}
+
+// Entrega as palavras ao barramento simulado, dividindo as transações nos bits de STOP.
+// A transferência é instantânea: 'done' é chamado antes do retorno.
+void hal_i2c_stream_start(int stream, uint8_t address, const uint16_t *words, size_t count,
+                          hal_i2c_stream_done_t done, void *ctx) {
+  static uint8_t transaction[2048];
+  size_t len = 0;
+
+  for (size_t i = 0; i < count; ++i) {
+    if (len < sizeof(transaction))
+      transaction[len++] = words[i] & 0xFF;
+
+    if (words[i] & HAL_I2C_STOP) {
+      hal_i2c_write(stream_port[stream], address, transaction, len);
+      len = 0;
+    }
+  }
+
+  if (done)
+    done(ctx);
+}
+
+// A transferência termina dentro de hal_i2c_stream_start: nunca há término a aguardar
+void hal_i2c_stream_wait(int stream) {
+}
+
+vssd1306_t *hal_host_panel(void) {
+  return &panel;
+}
+
+void hal_flash_read(uint32_t offset, void *dst, size_t len) {
+  vflash_read(&flash, offset, dst, len);
+}
+
+void hal_flash_erase(uint32_t offset) {
+  vflash_erase(&flash, offset);
+}
+
+void hal_flash_program(uint32_t offset, const void *src, size_t len) {
+  vflash_program(&flash, offset, src, len);
+}
+
+vflash_t *hal_host_flash(void) {
+  return &flash;
+}
+
+// Estatísticas de desgaste da flash: apagamentos (total e do setor mais apagado) e bytes gravados
+static void host_flash_report(void) {
+  uint32_t total = 0, worst = 0;
+
+  for (uint32_t i = 0; i < HAL_FLASH_LOG_SECTORS; ++i) {
+    total += flash.erases[i];
+    if (flash.erases[i] > worst)
+      worst = flash.erases[i];
+  }
+
+  printf("Flash: %u apagamentos (max. %u por setor), %u bytes gravados, %u bytes lidos\n",
+         total, worst, flash.programmed_bytes, flash.read_bytes);
+}
+
+// Interpreta uma linha de comando da simulação
+static void host_command(char *line) {
+  char path[128];
+  unsigned value;
+
+  if (strncmp(line, "console ", 8) == 0) {
+    host_console_write(line + 8);
+  } else if (sscanf(line, "pbm %127s", path) == 1) {
+    if (!vssd1306_dump_pbm(&panel, path))
+      fprintf(stderr, "Falha ao gravar %s\n", path);
+  } else if (sscanf(line, "wait %u", &value) == 1) {
+    vTaskDelay(pdMS_TO_TICKS(value));
+  } else if (strncmp(line, "drain", 5) == 0) {
+    while (console_tail != console_head)
+      vTaskDelay(pdMS_TO_TICKS(5));
+  } else if (strncmp(line, "quit", 4) == 0) {
+    printf("I2C: %u transacoes, %u bytes, %u bytes de dados\n",
+           panel.transactions, panel.bytes, panel.data_bytes);
+    host_flash_report();
+    if (telemetry_file)
+      fflush(telemetry_file);
+    exit(0);
+  } else if (sscanf(line, "%u", &value) == 1) {
+    hal_host_inject_gpio(value, HAL_GPIO_EDGE_FALL);
+    hal_host_inject_gpio(value, HAL_GPIO_EDGE_RISE);
+  }
+}
+
+// Lê a entrada padrão sem bloquear o escalonador. Comandos (um por linha):
+//   <gpio>        aperta e solta o botão do pino (ex.: 5 = botão A)
+//   wait <ms>     aguarda antes do próximo comando
+//   pbm <arquivo> salva o conteúdo do display
+//   console <txt> envia o texto ao console da aplicação (como o USB CDC da placa)
+//   drain         aguarda a aplicação ler todo o texto já enviado ao console
+//   quit          imprime estatísticas e encerra
+static void vHostInputTask(void *params) {
+  char line[160];
+  size_t len = 0;
+
+  while (true) {
+    struct pollfd input = { .fd = STDIN_FILENO, .events = POLLIN };
+    if (poll(&input, 1, 0) <= 0) {
+      vTaskDelay(pdMS_TO_TICKS(5));
+      continue;
+    }
+
+    char c;
+    if (read(STDIN_FILENO, &c, 1) != 1) {
+      // Fim da entrada: a simulação continua sem novos eventos
+      vTaskDelete(NULL);
+    }
+
+    if (c == '\n' || len == sizeof(line) - 1) {
+      line[len] = '\0';
+      host_command(line);
+      len = 0;
+    } else {
+      line[len++] = c;
+    }
+  }
+}
@@ -0,0 +1,24 @@
+#ifndef HAL_HOST_H
+#define HAL_HOST_H
+
+// Extensões da HAL disponíveis apenas na simulação para Linux
+
+#include "hal.h"
+#include "virtual_ssd1306.h"
+#include "virtual_flash.h"
+
+#define HAL_HOST_GPIO_COUNT 30
+
+// Gera uma borda no pino, executando o callback de interrupção registrado
+void hal_host_inject_gpio(uint gpio, uint32_t events);
+
+// Nível atual de um pino configurado como saída
+bool hal_host_gpio_level(uint gpio);
+
+// Display SSD1306 virtual ligado ao barramento I2C simulado
+vssd1306_t *hal_host_panel(void);
+
+// Flash virtual do registro de eventos (arquivo definido por PARKING_SIM_FLASH)
+vflash_t *hal_host_flash(void);
+
+#endif
@@ -0,0 +1,55 @@
+// Gerador das telas fixas: renderiza cada layout de lib/ui_layout.c com o mesmo código de
+// desenho do firmware e imprime lib/ui_screens.h (imagens no formato da RAM do ssd1306_t).
+//   render_screens > lib/ui_screens.h   (ou o alvo ui_screens da simulação)
+
+#include "ssd1306.h"
+#include "ui_layout.h"
+#include <stdio.h>
+
+// O gerador só desenha no buffer: as funções de barramento nunca são chamadas
+void hal_panic(const char *message) {
+  fprintf(stderr, "panic: %s\n", message);
+  exit(1);
+}
+
+int hal_i2c_write(hal_i2c_t port, uint8_t address, const uint8_t *src, size_t len) {
+  return (int)len;
+}
+
+void hal_i2c_wait_idle(hal_i2c_t port) {
+}
+
+int hal_i2c_stream_claim(hal_i2c_t port) {
+  return 0;
+}
+
+void hal_i2c_stream_start(int stream, uint8_t address, const uint16_t *words, size_t count,
+                          hal_i2c_stream_done_t done, void *ctx) {
+}
+
+void hal_i2c_stream_wait(int stream) {
+}
+
+static ssd1306_t ssd;
+
+int main(void) {
+  printf("#ifndef UI_SCREENS_H\n#define UI_SCREENS_H\n\n");
+  printf("// Gerado por host/render_screens.c a partir de lib/ui_layout.c. Não editar.\n");
+  printf("// Cada imagem tem o formato de ssd1306_t.ram_buffer sem o byte de controle:\n");
+  printf("// %u páginas por coluna, coluna a coluna (endereçamento vertical).\n\n", HEIGHT / 8);
+  printf("#include <stdint.h>\n");
+
+  for (uint8_t i = 0; i < ui_layout_count; i++) {
+    ssd1306_init(&ssd, WIDTH, HEIGHT, false, 0, 0);
+    ui_layouts[i].draw(&ssd);
+
+    printf("\nstatic const uint8_t ui_screen_%s[%u] = {", ui_layouts[i].name, SSD1306_BUFSIZE - 1);
+    for (size_t b = 1; b < ssd.bufsize; b++) {
+      printf("%s0x%02X,", (b - 1) % 16 ? " " : "\n  ", ssd.ram_buffer[b]);
+    }
+    printf("\n};\n");
+  }
+
+  printf("\n#endif\n");
+  return 0;
+}
@@ -0,0 +1,77 @@
+#include "telemetry_parse.h"
+#include <string.h>
+
+void telemetry_parser_init(telemetry_parser_t *parser, telemetry_record_fn_t on_record, void *ctx) {
+  memset(parser, 0, sizeof(*parser));
+  parser->on_record = on_record;
+  parser->ctx = ctx;
+  parser->prev = -1;
+  parser->expected_seq = -1;
+}
+
+// Quadro completo em buffer: confere o CRC e a sequência e entrega os registros
+static void telemetry_parser_frame(telemetry_parser_t *parser) {
+  size_t len = parser->frame_len - 2;
+  uint8_t count = parser->buffer[0], seq = parser->buffer[1];
+
+  uint16_t crc = parser->buffer[len] | parser->buffer[len + 1] << 8;
+  if (crc != telemetry_crc16(parser->buffer, len)) {
+    parser->crc_errors++;
+    return;
+  }
+
+  if (parser->expected_seq >= 0 && seq != parser->expected_seq)
+    parser->lost_frames += (uint8_t)(seq - parser->expected_seq);
+  parser->expected_seq = (seq + 1) & 0xFF;
+  parser->frames++;
+
+  for (uint8_t i = 0; i < count; i++) {
+    telemetry_record_t record;
+    memcpy(&record, &parser->buffer[2 + i * sizeof(record)], sizeof(record));
+    if (parser->records++ == 0)
+      parser->first_us = record.time_us;
+    parser->last_us = record.time_us;
+    if (parser->on_record)
+      parser->on_record(&record, parser->ctx);
+  }
+}
+
+void telemetry_parser_feed(telemetry_parser_t *parser, const uint8_t *data, size_t len) {
+  for (size_t i = 0; i < len; i++) {
+    uint8_t c = data[i];
+
+    // Procura o par de sincronismo
+    if (parser->frame_len == 0) {
+      if (parser->prev == TELEMETRY_SYNC0 && c == TELEMETRY_SYNC1) {
+        parser->prev = -1;
+        parser->frame_len = 2; // n e seq; o tamanho do quadro só é conhecido depois de 'n'
+        continue;
+      }
+      if (parser->prev >= 0)
+        parser->skipped++;
+      parser->prev = c;
+      continue;
+    }
+
+    parser->buffer[parser->pos++] = c;
+    if (parser->pos < parser->frame_len)
+      continue;
+
+    // n e seq lidos: valida a contagem e passa a esperar os registros e o CRC
+    if (parser->pos == 2 && parser->frame_len == 2) {
+      uint8_t count = parser->buffer[0];
+      if (count < 1 || count > TELEMETRY_FRAME_MAX) {
+        parser->crc_errors++;
+        parser->pos = 0;
+        parser->frame_len = 0;
+        continue;
+      }
+      parser->frame_len = 2 + count * sizeof(telemetry_record_t) + 2;
+      continue;
+    }
+
+    telemetry_parser_frame(parser);
+    parser->pos = 0;
+    parser->frame_len = 0;
+  }
+}
@@ -0,0 +1,36 @@
+#ifndef TELEMETRY_PARSE_H
+#define TELEMETRY_PARSE_H
+
+// Leitor incremental dos quadros de telemetria (lib/telemetry.h), usado pelo decodificador e
+// pelos testes: recebe os bytes em pedaços de qualquer tamanho, procura o sincronismo, valida
+// o CRC e a sequência e entrega cada registro a uma função.
+
+#include "telemetry.h"
+
+typedef void (*telemetry_record_fn_t)(const telemetry_record_t *record, void *ctx);
+
+typedef struct {
+  telemetry_record_fn_t on_record;
+  void *ctx;
+
+  // Quadro em montagem: buffer[0] = n, buffer[1] = seq, registros e CRC
+  uint8_t buffer[2 + TELEMETRY_FRAME_MAX * sizeof(telemetry_record_t) + 2];
+  size_t pos;
+  size_t frame_len; // 0 enquanto procura o sincronismo
+  int prev;         // Byte anterior durante a procura (-1 logo após um quadro)
+  int expected_seq; // -1 antes do primeiro quadro
+
+  // Estatísticas
+  unsigned long frames;
+  unsigned long records;
+  unsigned long crc_errors; // Inclui contagens de registros inválidas
+  unsigned long lost_frames;
+  unsigned long skipped; // Bytes fora de quadros
+  uint32_t first_us;
+  uint32_t last_us;
+} telemetry_parser_t;
+
+void telemetry_parser_init(telemetry_parser_t *parser, telemetry_record_fn_t on_record, void *ctx);
+void telemetry_parser_feed(telemetry_parser_t *parser, const uint8_t *data, size_t len);
+
+#endif
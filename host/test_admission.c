@@ -0,0 +1,181 @@
+// Teste de carga da admissão (lib/admission.c) sobre a porta POSIX do FreeRTOS.
+// Várias tarefas disputam entradas e saídas enquanto outra dispara resets. Após cada operação
+// confere que fichas livres mais vagas ocupadas nunca passam da capacidade (as entradas em andamento
+// ficam com a ficha); ao final, com as tarefas paradas, que somam exatamente a capacidade. Informa
+// as operações por segundo.
+//   test_admission [duracao_ms]
+
+#include "admission.h"
+#include "hal_fake.h"
+#include "task.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define TEST_WORKERS 8
+#define TEST_DURATION_MS 2000
+#define TEST_RESET_PERIOD_MS 5
+
+static parking_zone_t zones[] = {
+  { .name = "N1", .capacity = 4 },
+  { .name = "N2", .capacity = 4 },
+};
+static parking_lot_t lot;
+static event_log_t log_;
+static admission_t admission;
+
+typedef struct {
+  uint32_t seed;
+  uint32_t enters, enter_refused, leaves, leave_refused;
+} worker_t;
+
+static worker_t workers[TEST_WORKERS];
+static volatile bool stop = false;
+static volatile uint32_t finished = 0, resets = 0;
+static uint32_t checks = 0, violations = 0; // Verificações de fichas + ocupadas <= capacidade (sob o mutex)
+static uint32_t duration_ms = TEST_DURATION_MS;
+
+static StackType_t worker_stacks[TEST_WORKERS][configMINIMAL_STACK_SIZE];
+static StaticTask_t worker_tcbs[TEST_WORKERS];
+static StackType_t reset_stack[configMINIMAL_STACK_SIZE], control_stack[configMINIMAL_STACK_SIZE];
+static StaticTask_t reset_tcb, control_tcb;
+static StackType_t idle_stack[configMINIMAL_STACK_SIZE], timer_stack[configTIMER_TASK_STACK_DEPTH];
+static StaticTask_t idle_tcb, timer_tcb;
+
+static uint32_t xorshift(uint32_t *state) {
+  uint32_t x = *state;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  return *state = x;
+}
+
+// Confere o invariante sob o mutex das zonas
+static void check_capacity(void) {
+  admission_lock(&admission);
+  if (lot.occupied + admission_free_tokens(&admission) > lot.capacity)
+    violations++;
+  checks++;
+  admission_unlock(&admission);
+}
+
+// Entradas mais frequentes que saídas, para o estacionamento ficar perto de cheio
+static void vWorkerTask(void *params) {
+  worker_t *w = params;
+
+  while (!stop) {
+    if (xorshift(&w->seed) % 100 < 60) {
+      if (admission_try_enter(&admission)) {
+        w->enters++;
+        check_capacity();
+      } else {
+        w->enter_refused++;
+      }
+    } else if (admission_try_leave(&admission)) {
+      w->leaves++;
+      check_capacity();
+    } else {
+      w->leave_refused++;
+    }
+
+    if (xorshift(&w->seed) % 16 == 0)
+      taskYIELD();
+  }
+
+  taskENTER_CRITICAL();
+  finished++;
+  taskEXIT_CRITICAL();
+  vTaskDelete(NULL);
+}
+
+// Reseta o estacionamento a cada período. Antes, segura o mutex por um tick: as entradas que
+// chegam nesse meio tempo já tiraram a ficha e disputam o mutex com o reset (com prioridade maior)
+static void vResetTask(void *params) {
+  while (!stop) {
+    vTaskDelay(pdMS_TO_TICKS(TEST_RESET_PERIOD_MS));
+    admission_lock(&admission);
+    vTaskDelay(1);
+    admission_unlock(&admission);
+    admission_reset(&admission);
+    check_capacity();
+    resets++;
+  }
+
+  taskENTER_CRITICAL();
+  finished++;
+  taskEXIT_CRITICAL();
+  vTaskDelete(NULL);
+}
+
+static void vControlTask(void *params) {
+  uint64_t start_us = hal_time_us();
+  vTaskDelay(pdMS_TO_TICKS(duration_ms));
+  stop = true;
+  while (finished < TEST_WORKERS + 1)
+    vTaskDelay(1);
+  uint64_t elapsed_us = hal_time_us() - start_us;
+
+  worker_t total = { 0 };
+  for (int i = 0; i < TEST_WORKERS; i++) {
+    total.enters += workers[i].enters;
+    total.enter_refused += workers[i].enter_refused;
+    total.leaves += workers[i].leaves;
+    total.leave_refused += workers[i].leave_refused;
+  }
+
+  uint16_t counted = 0;
+  for (uint8_t z = 0; z < lot.zone_count; z++)
+    counted += parking_zone_count(&lot.zones[z]);
+  uint16_t tokens = admission_free_tokens(&admission);
+
+  uint32_t ops = total.enters + total.enter_refused + total.leaves + total.leave_refused;
+  printf("%d tarefas, %lu ms: %lu operacoes (%llu op/s), %lu entradas (%lu recusadas), %lu saidas (%lu recusadas), "
+         "%lu resets\n",
+         TEST_WORKERS, (unsigned long)(elapsed_us / 1000), (unsigned long)ops,
+         (unsigned long long)(ops * 1000000ull / elapsed_us), (unsigned long)total.enters,
+         (unsigned long)total.enter_refused, (unsigned long)total.leaves, (unsigned long)total.leave_refused,
+         (unsigned long)resets);
+  printf("Ocupacao final %u (bitmaps %u), fichas livres %u, capacidade %u, %lu de %lu verificacoes acima da "
+         "capacidade\n", lot.occupied, counted, tokens, lot.capacity, (unsigned long)violations,
+         (unsigned long)checks);
+
+  bool ok = violations == 0 && counted == lot.occupied && lot.occupied + tokens == lot.capacity &&
+            total.enters > 0 && total.leaves > 0;
+  printf("%s\n", ok ? "ok" : "FALHOU");
+  exit(ok ? 0 : 1);
+}
+
+int main(int argc, char **argv) {
+  if (argc > 1)
+    duration_ms = strtoul(argv[1], NULL, 10);
+
+  hal_fake_init();
+  parking_init(&lot, zones, sizeof(zones) / sizeof(zones[0]));
+  event_log_init(&log_, &lot);
+  admission_init(&admission, &lot, &log_);
+
+  for (int i = 0; i < TEST_WORKERS; i++) {
+    workers[i].seed = 0x9E3779B9u * (i + 1);
+    xTaskCreateStatic(vWorkerTask, "Teste: Vagas", configMINIMAL_STACK_SIZE, &workers[i], tskIDLE_PRIORITY + 1,
+                      worker_stacks[i], &worker_tcbs[i]);
+  }
+  xTaskCreateStatic(vResetTask, "Teste: Reset", configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY + 2, reset_stack,
+                    &reset_tcb);
+  xTaskCreateStatic(vControlTask, "Teste: Controle", configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY + 3,
+                    control_stack, &control_tcb);
+
+  vTaskStartScheduler();
+  hal_panic("Scheduler encerrado");
+}
+
+// Memória das tarefas do kernel (configSUPPORT_STATIC_ALLOCATION)
+void vApplicationGetIdleTaskMemory(StaticTask_t **tcb, StackType_t **stack, configSTACK_DEPTH_TYPE *depth) {
+  *tcb = &idle_tcb;
+  *stack = idle_stack;
+  *depth = configMINIMAL_STACK_SIZE;
+}
+
+void vApplicationGetTimerTaskMemory(StaticTask_t **tcb, StackType_t **stack, configSTACK_DEPTH_TYPE *depth) {
+  *tcb = &timer_tcb;
+  *stack = timer_stack;
+  *depth = configTIMER_TASK_STACK_DEPTH;
+}
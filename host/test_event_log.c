@@ -0,0 +1,167 @@
+// Teste do registro de eventos (lib/event_log.c) sobre a flash virtual da HAL falsa. Confere que
+// registrar eventos não apaga nem grava a flash (só a tarefa de gravação, event_log_process), que
+// as gravações periódicas completam o mesmo setor em vez de gastar um setor cada, que o setor
+// seguinte só é apagado quando o anterior enche, o descarte com os dois buffers cheios e que um
+// novo boot restaura a ocupação e continua no setor restaurado.
+
+#include "event_log.h"
+#include "hal_fake.h"
+#include "task.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TEST_ZONE_CAPACITY 8
+
+static parking_zone_t zones[] = {
+  { .name = "N1", .capacity = TEST_ZONE_CAPACITY },
+  { .name = "N2", .capacity = TEST_ZONE_CAPACITY },
+};
+static parking_zone_t boot_zones[] = {
+  { .name = "N1", .capacity = TEST_ZONE_CAPACITY },
+  { .name = "N2", .capacity = TEST_ZONE_CAPACITY },
+};
+static parking_lot_t lot, boot_lot;
+static event_log_t log_, boot_log;
+static uint32_t seed = 0x9E3779B9u;
+static int failures = 0;
+
+static StackType_t test_stack[configMINIMAL_STACK_SIZE * 4];
+static StaticTask_t test_tcb;
+static StackType_t idle_stack[configMINIMAL_STACK_SIZE], timer_stack[configTIMER_TASK_STACK_DEPTH];
+static StaticTask_t idle_tcb, timer_tcb;
+
+static void check(bool condition, const char *what) {
+  printf("%-60s %s\n", what, condition ? "ok" : "FALHOU");
+  if (!condition)
+    failures++;
+}
+
+static uint32_t xorshift(uint32_t *state) {
+  uint32_t x = *state;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  return *state = x;
+}
+
+// Entradas e saídas aleatórias, registradas como a admissão faz (zonas alteradas antes do registro)
+static void generate(uint32_t count) {
+  parking_spot_t spot;
+
+  for (uint32_t i = 0; i < count; i++) {
+    if (xorshift(&seed) % 2 == 0 && parking_enter(&lot, PARKING_ZONE_ANY, &spot))
+      event_log_append(&log_, EVENT_LOG_ENTER, spot);
+    else if (parking_leave(&lot, PARKING_ZONE_ANY, &spot))
+      event_log_append(&log_, EVENT_LOG_LEAVE, spot);
+    else if (parking_enter(&lot, PARKING_ZONE_ANY, &spot))
+      event_log_append(&log_, EVENT_LOG_ENTER, spot);
+  }
+}
+
+static uint32_t erases(void) {
+  vflash_t *flash = hal_fake_flash();
+  uint32_t total = 0;
+
+  for (uint8_t i = 0; i < HAL_FLASH_LOG_SECTORS; i++)
+    total += flash->erases[i];
+  return total;
+}
+
+// Grava tudo o que estiver pendente, como a tarefa faria a cada pedido
+static void sync_now(event_log_t *log) {
+  event_log_sync(log);
+  while (event_log_process(log, 0)) {
+  }
+}
+
+// Novo boot: zonas vazias restauradas da flash e comparadas com o estado atual
+static bool reboot_matches(void) {
+  for (uint8_t z = 0; z < boot_lot.zone_count; z++)
+    memset(boot_zones[z].spots, 0, sizeof(boot_zones[z].spots));
+  parking_init(&boot_lot, boot_zones, sizeof(boot_zones) / sizeof(boot_zones[0]));
+  if (!event_log_init(&boot_log, &boot_lot) || boot_lot.occupied != lot.occupied)
+    return false;
+
+  for (uint8_t z = 0; z < lot.zone_count; z++) {
+    if (memcmp(boot_zones[z].spots, zones[z].spots, sizeof(zones[z].spots)) != 0)
+      return false;
+  }
+  return true;
+}
+
+static void vTestTask(void *params) {
+  vflash_t *flash = hal_fake_flash();
+  uint16_t capacity = log_.capacity;
+
+  // Eventos só em RAM até a tarefa de gravação atender o pedido
+  generate(10);
+  check(erases() == 0 && flash->programmed_bytes == 0, "eventos registrados sem acesso a flash");
+  sync_now(&log_);
+  check(erases() == 1 && log_.written_sectors == 1, "primeira gravacao apaga um setor");
+
+  // Gravações periódicas seguidas completam o mesmo setor
+  for (int i = 0; i < 20; i++) {
+    generate(5);
+    sync_now(&log_);
+  }
+  check(erases() == 1, "vinte gravacoes periodicas no mesmo setor");
+  check(flash->programmed_bytes <= 21 * 2 * HAL_FLASH_PAGE_SIZE, "apenas as paginas com eventos novos gravadas");
+  check(reboot_matches() && boot_log.restored_records == 110, "novo boot restaura a ocupacao e os eventos");
+
+  // Setor cheio: o próximo só é apagado pela tarefa
+  uint32_t programmed = flash->programmed_bytes;
+  generate(capacity - 110 + 3);
+  check(erases() == 1 && flash->programmed_bytes == programmed, "setor cheio sem acesso a flash no registro");
+  sync_now(&log_);
+  check(erases() == 2 && reboot_matches() && boot_log.restored_records == 3, "setor seguinte apos o cheio");
+
+  // Sem a tarefa, os dois buffers enchem e os eventos seguintes são descartados
+  generate(capacity - 3 + capacity + 4);
+  check(log_.dropped == 4 && erases() == 2, "descarte com os dois buffers cheios");
+  sync_now(&log_);
+  check(erases() == 3, "os dois setores gravados em ordem");
+  generate(1);
+  sync_now(&log_);
+  check(log_.dropped == 4 && erases() == 4, "registro volta a aceitar eventos apos a gravacao");
+  check(reboot_matches() && boot_log.restored_records == 1, "ocupacao restaurada apos o descarte");
+
+  // Novo boot do próprio registro: continua no setor restaurado, sem apagar outro
+  generate(7);
+  sync_now(&log_);
+  uint32_t before = erases();
+  for (uint8_t z = 0; z < lot.zone_count; z++)
+    memset(zones[z].spots, 0, sizeof(zones[z].spots));
+  parking_init(&lot, zones, lot.zone_count);
+  check(event_log_init(&log_, &lot) && log_.restored_records == 8, "restauracao antes de continuar");
+  generate(10);
+  sync_now(&log_);
+  check(erases() == before && reboot_matches() && boot_log.restored_records == 18, "boot continua no mesmo setor");
+
+  printf("%s\n", failures ? "FALHOU" : "ok");
+  exit(failures ? 1 : 0);
+}
+
+int main(void) {
+  hal_fake_init();
+  parking_init(&lot, zones, sizeof(zones) / sizeof(zones[0]));
+  event_log_init(&log_, &lot);
+
+  xTaskCreateStatic(vTestTask, "Teste: Registro", sizeof(test_stack) / sizeof(test_stack[0]), NULL,
+                    tskIDLE_PRIORITY + 1, test_stack, &test_tcb);
+  vTaskStartScheduler();
+  hal_panic("Scheduler encerrado");
+}
+
+// Memória das tarefas do kernel (configSUPPORT_STATIC_ALLOCATION)
+void vApplicationGetIdleTaskMemory(StaticTask_t **tcb, StackType_t **stack, configSTACK_DEPTH_TYPE *depth) {
+  *tcb = &idle_tcb;
+  *stack = idle_stack;
+  *depth = configMINIMAL_STACK_SIZE;
+}
+
+void vApplicationGetTimerTaskMemory(StaticTask_t **tcb, StackType_t **stack, configSTACK_DEPTH_TYPE *depth) {
+  *tcb = &timer_tcb;
+  *stack = timer_stack;
+  *depth = configTIMER_TASK_STACK_DEPTH;
+}
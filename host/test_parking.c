@@ -0,0 +1,66 @@
+// Teste dos limites de lib/parking.c: zonas acima de PARKING_ZONE_MAX_SPOTS vagas ou com a
+// capacidade total acima de 16 bits são recusadas (o estacionamento fica sem vagas), e uma zona
+// com exatamente o máximo, ou com uma palavra incompleta, é ocupada e liberada vaga a vaga até
+// os limites.
+
+#include "parking.h"
+#include <stdio.h>
+
+#define TEST_BIG_ZONES (UINT16_MAX / PARKING_ZONE_MAX_SPOTS + 1)
+
+static parking_zone_t zones[TEST_BIG_ZONES];
+static parking_lot_t lot;
+static int failures = 0;
+
+static void check(bool condition, const char *what) {
+  printf("%-60s %s\n", what, condition ? "ok" : "FALHOU");
+  if (!condition)
+    failures++;
+}
+
+// Ocupa a zona inteira pela busca da primeira vaga livre e libera tudo pela busca da ocupada
+static bool fill_and_empty(uint8_t zone) {
+  parking_spot_t spot;
+  uint16_t capacity = lot.zones[zone].capacity;
+
+  for (uint16_t i = 0; i < capacity; i++) {
+    if (!parking_enter(&lot, zone, &spot) || spot.index != i)
+      return false;
+  }
+  if (parking_enter(&lot, zone, &spot) || parking_zone_count(&lot.zones[zone]) != capacity)
+    return false;
+
+  for (uint16_t i = 0; i < capacity; i++) {
+    if (!parking_leave(&lot, zone, &spot) || spot.index != i)
+      return false;
+  }
+  return !parking_leave(&lot, zone, &spot) && lot.occupied == 0;
+}
+
+int main(void) {
+  parking_spot_t spot;
+
+  // Uma vaga além dos bitmaps
+  zones[0] = (parking_zone_t){ .name = "N1", .capacity = 4 };
+  zones[1] = (parking_zone_t){ .name = "N2", .capacity = PARKING_ZONE_MAX_SPOTS + 1 };
+  check(!parking_init(&lot, zones, 2), "zona acima do maximo recusada");
+  check(lot.zone_count == 0 && lot.capacity == 0, "estacionamento sem zonas");
+  check(!parking_enter(&lot, PARKING_ZONE_ANY, &spot), "entrada recusada");
+
+  // Cada zona cabe, mas a soma passa do contador de 16 bits
+  for (uint8_t z = 0; z < TEST_BIG_ZONES; z++)
+    zones[z] = (parking_zone_t){ .name = "N", .capacity = PARKING_ZONE_MAX_SPOTS };
+  check(!parking_init(&lot, zones, TEST_BIG_ZONES), "capacidade total acima de 16 bits recusada");
+  check(lot.capacity == 0, "estacionamento sem vagas");
+
+  // Zona com o máximo de vagas e zona terminando no meio de uma palavra
+  zones[0] = (parking_zone_t){ .name = "N1", .capacity = PARKING_ZONE_MAX_SPOTS };
+  zones[1] = (parking_zone_t){ .name = "N2", .capacity = PARKING_WORD_BITS + 1 };
+  check(parking_init(&lot, zones, 2), "zonas dentro do limite aceitas");
+  check(lot.capacity == PARKING_ZONE_MAX_SPOTS + PARKING_WORD_BITS + 1, "capacidade total");
+  check(fill_and_empty(0), "zona com o maximo ocupada e liberada");
+  check(fill_and_empty(1), "zona com palavra incompleta ocupada e liberada");
+
+  printf("%s\n", failures ? "FALHOU" : "ok");
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,123 @@
+// Teste do envio assíncrono do display (ssd1306_send_data_async) sobre a HAL falsa, em que a
+// transferência só termina quando o teste faz o papel da interrupção do DMA. Confere que um
+// segundo envio é recusado enquanto o primeiro está em andamento, que o painel recebe o quadro
+// do momento do envio (não o desenhado depois), a ordem do callback e que ssd1306_wait só
+// retorna após a conclusão vinda de outra thread, bloqueada (sem consumir CPU) até lá.
+
+#include "ssd1306.h"
+#include "hal_fake.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define TEST_WAIT_DELAY_US 20000
+
+static ssd1306_t ssd;
+static uint32_t callbacks = 0;
+static bool busy_in_callback = true;
+static void *callback_ctx = NULL;
+static int failures = 0;
+
+static void check(bool condition, const char *what) {
+  printf("%-60s %s\n", what, condition ? "ok" : "FALHOU");
+  if (!condition)
+    failures++;
+}
+
+static void on_flush_done(ssd1306_t *display, void *ctx) {
+  callbacks++;
+  busy_in_callback = ssd1306_busy(display);
+  callback_ctx = ctx;
+}
+
+// O painel virtual mostra exatamente a imagem (no formato de ram_buffer, sem o byte de controle)
+static bool panel_shows(const uint8_t *image) {
+  for (uint8_t x = 0; x < ssd.width; x++) {
+    for (uint8_t y = 0; y < ssd.height; y++) {
+      bool expected = image[(y >> 3) + (x << 3)] & (1 << (y & 7));
+      if (vssd1306_get_pixel(hal_fake_panel(), x, y) != expected)
+        return false;
+    }
+  }
+  return true;
+}
+
+// Tempo de CPU consumido pela thread atual (us)
+static uint64_t thread_cpu_us(void) {
+  struct timespec now;
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+  return (uint64_t)now.tv_sec * 1000000u + now.tv_nsec / 1000;
+}
+
+static void *complete_later(void *arg) {
+  usleep(TEST_WAIT_DELAY_US);
+  hal_fake_stream_complete();
+  return NULL;
+}
+
+int main(void) {
+  uint8_t frame[WIDTH * HEIGHT / 8];
+  int ctx_marker;
+
+  hal_fake_init();
+  ssd1306_init(&ssd, WIDTH, HEIGHT, false, HAL_FAKE_PANEL_ADDRESS, 0);
+  ssd1306_config(&ssd);
+
+  // Primeiro envio: completo, pendente até a "interrupção"
+  ssd1306_rect(&ssd, 4, 4, 40, 20, true, true);
+  memcpy(frame, &ssd.ram_buffer[1], sizeof(frame));
+  check(ssd1306_send_data_async(&ssd, on_flush_done, &ctx_marker), "envio iniciado");
+  check(ssd1306_busy(&ssd) && hal_fake_stream_pending() == 1, "transferencia pendente");
+
+  // Desenho e novo envio com o primeiro em andamento: recusado, sem reprogramar o fluxo
+  ssd1306_draw_string(&ssd, "ABC", 60, 40);
+  check(!ssd1306_send_data_async(&ssd, on_flush_done, &ctx_marker), "segundo envio recusado enquanto ocupado");
+  check(hal_fake_stream_starts() == 1 && callbacks == 0, "fluxo iniciado uma vez, sem callback");
+
+  check(hal_fake_stream_complete(), "conclusao do DMA");
+  check(callbacks == 1 && callback_ctx == &ctx_marker, "callback chamado uma vez com o contexto");
+  check(!busy_in_callback, "display livre dentro do callback");
+  check(panel_shows(frame), "painel com o quadro do momento do envio");
+
+  // O texto desenhado durante o envio sai no envio seguinte
+  memcpy(frame, &ssd.ram_buffer[1], sizeof(frame));
+  check(ssd1306_send_data_async(&ssd, on_flush_done, &ctx_marker), "envio seguinte aceito");
+  check(hal_fake_stream_complete() && callbacks == 2, "segunda conclusao");
+  check(panel_shows(frame), "painel com o texto desenhado durante o envio");
+  check(!ssd1306_send_data_async(&ssd, on_flush_done, NULL), "sem alteracoes, nada a enviar");
+
+  // Envios seguidos: cada um só começa depois da conclusão do anterior
+  for (uint8_t i = 0; i < 8; i++) {
+    ssd1306_rect(&ssd, 48, i * 16, 8, 8, true, true);
+    if (!ssd1306_send_data_async(&ssd, on_flush_done, NULL) || !hal_fake_stream_complete())
+      break;
+  }
+  memcpy(frame, &ssd.ram_buffer[1], sizeof(frame));
+  check(callbacks == 10 && hal_fake_stream_pending() == 0 && panel_shows(frame), "oito envios seguidos");
+
+  // ssd1306_wait bloqueia até a conclusão chegar de outra thread e então espera o barramento.
+  // O término do envio anterior, nunca aguardado, não pode liberar esta espera antes da hora
+  ssd1306_line(&ssd, 0, 63, 127, 0, true);
+  memcpy(frame, &ssd.ram_buffer[1], sizeof(frame));
+  check(ssd1306_send_data_async(&ssd, on_flush_done, NULL), "envio antes do wait");
+  uint32_t idle_calls = hal_fake_wait_idle_calls();
+
+  pthread_t thread;
+  pthread_create(&thread, NULL, complete_later, NULL);
+  uint64_t start_us = hal_time_us(), start_cpu_us = thread_cpu_us();
+  ssd1306_wait(&ssd);
+  uint64_t waited_us = hal_time_us() - start_us, cpu_us = thread_cpu_us() - start_cpu_us;
+  pthread_join(thread, NULL);
+
+  printf("wait: %llu us, %llu us de CPU\n", (unsigned long long)waited_us, (unsigned long long)cpu_us);
+  check(waited_us >= TEST_WAIT_DELAY_US / 2 && callbacks == 11 && !ssd1306_busy(&ssd),
+        "wait retorna apos a conclusao");
+  check(cpu_us < TEST_WAIT_DELAY_US / 4, "wait bloqueado, sem espera ativa");
+  check(hal_fake_wait_idle_calls() == idle_calls + 1, "wait aguarda o barramento ocioso");
+  check(panel_shows(frame), "painel atualizado apos o wait");
+
+  printf("%s\n", failures ? "FALHOU" : "ok");
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,246 @@
+// Reprodução de traços de eventos dos portões na simulação, com o tempo acelerado.
+// O traço (gravado ou um cenário sintético) vira um roteiro para o parking_sim: cada rajada é
+// entregue pelo comando de injeção do console ("i <padrao> <n> <intervalo_us>"), que usa as mesmas
+// filas da interrupção dos botões e as tarefas reais dos portões e do display.
+//
+//   trace_replay [-x fator] [-s parking_sim] <rush|mixed|resets|arquivo>
+//
+// Sem -s, apenas imprime o roteiro. Com -s, executa a simulação, resume as taxas, descartes e
+// latências (comando 't') e retorna erro se a ocupação final não conferir ou eventos não forem tratados.
+//
+// Arquivo: uma linha "<tempo_us> <e|s|r>" por evento, ou a saída do telemetry_decode (linhas "portao").
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <unistd.h>
+
+#define REPLAY_MAX_EVENTS 100000
+#define REPLAY_PATTERN_MAX 24   // INJECT_PATTERN_MAX do main.c
+#define REPLAY_BURST_GAP_US 500000 // Pausa (no tempo do traço) que encerra uma rajada
+#define REPLAY_DEFAULT_SPEEDUP 10
+
+typedef struct {
+  uint64_t time_us;
+  char gate; // 'e', 's' ou 'r'
+} replay_event_t;
+
+static replay_event_t events[REPLAY_MAX_EVENTS];
+static size_t event_count = 0;
+
+static void replay_add(uint64_t time_us, char gate) {
+  if (event_count < REPLAY_MAX_EVENTS)
+    events[event_count++] = (replay_event_t){ time_us, gate };
+}
+
+// Horário de pico: rajadas de chegadas com algumas saídas, separadas por pausas
+static void scenario_rush(void) {
+  uint64_t t = 0;
+
+  for (int burst = 0; burst < 10; burst++) {
+    for (int i = 0; i < 16; i++, t += 150000)
+      replay_add(t, i % 4 == 3 ? 's' : 'e');
+    t += 2000000;
+  }
+}
+
+// Entradas e saídas simultâneas: pares de eventos no mesmo instante
+static void scenario_mixed(void) {
+  for (uint64_t t = 0; t < 40000000; t += 100000) {
+    replay_add(t, 'e');
+    replay_add(t, 's');
+  }
+}
+
+// Rajadas de resets com o estacionamento enchendo e esvaziando
+static void scenario_resets(void) {
+  uint64_t t = 0;
+
+  for (int round = 0; round < 5; round++) {
+    for (int i = 0; i < 12; i++, t += 50000)
+      replay_add(t, 'e');
+    for (int i = 0; i < 20; i++, t += 10000)
+      replay_add(t, i % 2 ? 's' : 'r');
+    t += 1000000;
+  }
+}
+
+static int compare_events(const void *a, const void *b) {
+  const replay_event_t *x = a, *y = b;
+  return x->time_us < y->time_us ? -1 : x->time_us > y->time_us;
+}
+
+// Lê o traço: "<tempo_us> <e|s|r>" ou linhas "portao gate=N" do telemetry_decode
+static bool replay_load(const char *path) {
+  FILE *in = fopen(path, "r");
+  if (!in) {
+    perror(path);
+    return false;
+  }
+
+  char line[256], word[16];
+  unsigned long long time_us;
+  while (fgets(line, sizeof(line), in)) {
+    if (sscanf(line, "%llu %15s", &time_us, word) != 2)
+      continue;
+
+    const char *gate = strstr(line, "gate=");
+    if (strcmp(word, "portao") == 0 && gate && gate[5] >= '0' && gate[5] <= '2')
+      replay_add(time_us, "esr"[gate[5] - '0']);
+    else if (word[1] == '\0' && strchr("esr", word[0]))
+      replay_add(time_us, word[0]);
+  }
+  fclose(in);
+
+  // O tempo do telemetry_decode é de 32 bits: desfaz as voltas antes de ordenar
+  for (size_t i = 1; i < event_count; i++) {
+    while (events[i].time_us + 0x80000000ull < events[i - 1].time_us)
+      events[i].time_us += 0x100000000ull;
+  }
+  qsort(events, event_count, sizeof(events[0]), compare_events);
+  return true;
+}
+
+// Escreve o roteiro: cada rajada (até REPLAY_PATTERN_MAX eventos sem pausa longa) é uma injeção
+// com o intervalo médio da rajada; entre as rajadas, o tempo do traço dividido pelo fator
+static void replay_script(FILE *out, unsigned speedup) {
+  // Começa com o estacionamento vazio e as latências zeradas
+  fprintf(out, "wait 50\nconsole i r\nconsole z\n");
+
+  size_t i = 0;
+  while (i < event_count) {
+    char pattern[REPLAY_PATTERN_MAX + 1];
+    size_t n = 0;
+
+    while (i + n < event_count && n < REPLAY_PATTERN_MAX &&
+           (n == 0 || events[i + n].time_us - events[i + n - 1].time_us < REPLAY_BURST_GAP_US)) {
+      pattern[n] = events[i + n].gate;
+      n++;
+    }
+    pattern[n] = '\0';
+
+    uint64_t span_us = events[i + n - 1].time_us - events[i].time_us;
+    uint64_t interval_us = n > 1 ? span_us / (n - 1) / speedup : 0;
+    fprintf(out, "drain\nconsole i %s %zu %llu\n", pattern, n, (unsigned long long)interval_us);
+
+    i += n;
+    if (i < event_count) {
+      uint64_t gap_ms = (events[i].time_us - events[i - n].time_us) / speedup / 1000;
+      if (gap_ms > 0)
+        fprintf(out, "wait %llu\n", (unsigned long long)gap_ms);
+    }
+  }
+
+  // O 't' só é lido depois da última injeção terminar
+  fprintf(out, "console t\ndrain\nwait 200\nquit\n");
+}
+
+// Executa a simulação com o roteiro e resume os relatórios das injeções
+static int replay_run(const char *sim, unsigned speedup) {
+  char script[] = "/tmp/trace_replay_XXXXXX";
+  int fd = mkstemp(script);
+  FILE *out = fd >= 0 ? fdopen(fd, "w") : NULL;
+  if (!out) {
+    perror("roteiro");
+    return 1;
+  }
+  replay_script(out, speedup);
+  fclose(out);
+
+  char command[512];
+  snprintf(command, sizeof(command), "%s < %s", sim, script);
+  FILE *in = popen(command, "r");
+  if (!in) {
+    perror(sim);
+    unlink(script);
+    return 1;
+  }
+
+  unsigned long sent = 0, dropped = 0, accepted = 0, rejected = 0, pending = 0, errors = 0, injections = 0;
+  unsigned long long handled_us = 0, handled = 0;
+  bool latency_table = false;
+  char line[256];
+
+  while (fgets(line, sizeof(line), in)) {
+    unsigned long a, b, c, d;
+
+    if (sscanf(line, "Injecao: %lu enviado(s), %lu descartado(s) (fila cheia), %lu aceito(s), %lu recusado(s)",
+               &a, &b, &c, &d) == 4) {
+      // A primeira injeção é o reset inicial do roteiro
+      if (injections++ == 0)
+        continue;
+      sent += a;
+      dropped += b;
+      accepted += c;
+      rejected += d;
+      handled += c + d;
+    } else if (sscanf(line, "Oferta: %lu eventos/s em %lu us; tratados: %lu eventos/s em %lu us", &a, &b, &c,
+                      &d) == 4) {
+      if (injections > 1)
+        handled_us += d;
+    } else if (sscanf(line, "Tempo esgotado: %lu", &a) == 1) {
+      pending += a;
+    } else if (strncmp(line, "Ocupacao:", 9) == 0) {
+      if (strstr(line, "ERRO")) {
+        errors++;
+        fputs(line, stdout);
+      }
+    } else if (strncmp(line, "etapa (us)", 10) == 0) {
+      latency_table = true;
+    } else if (strncmp(line, "tarefa", 6) == 0 || strncmp(line, "Boot", 4) == 0) {
+      latency_table = false;
+    }
+
+    if (latency_table)
+      fputs(line, stdout);
+  }
+  int status = pclose(in);
+  unlink(script);
+
+  printf("%zu eventos em %lu injecoes (fator %ux): %lu enviados, %lu descartados, %lu aceitos, %lu recusados\n",
+         event_count, injections ? injections - 1 : 0, speedup, sent, dropped, accepted, rejected);
+  printf("Tratados: %llu eventos/s; ocupacao final %s; %lu evento(s) nao tratado(s)\n",
+         handled_us ? handled * 1000000 / handled_us : 0, errors ? "INCORRETA" : "correta", pending);
+
+  return status != 0 || errors > 0 || pending > 0 || injections == 0;
+}
+
+int main(int argc, char **argv) {
+  unsigned speedup = REPLAY_DEFAULT_SPEEDUP;
+  const char *sim = NULL;
+  int opt;
+
+  while ((opt = getopt(argc, argv, "x:s:")) != -1) {
+    if (opt == 'x')
+      speedup = strtoul(optarg, NULL, 10);
+    else if (opt == 's')
+      sim = optarg;
+  }
+  if (optind != argc - 1 || speedup == 0) {
+    fprintf(stderr, "Uso: %s [-x fator] [-s parking_sim] <rush|mixed|resets|arquivo>\n", argv[0]);
+    return 2;
+  }
+
+  const char *trace = argv[optind];
+  if (strcmp(trace, "rush") == 0)
+    scenario_rush();
+  else if (strcmp(trace, "mixed") == 0)
+    scenario_mixed();
+  else if (strcmp(trace, "resets") == 0)
+    scenario_resets();
+  else if (!replay_load(trace))
+    return 1;
+
+  if (event_count == 0) {
+    fprintf(stderr, "Traco vazio\n");
+    return 1;
+  }
+
+  if (!sim) {
+    replay_script(stdout, speedup);
+    return 0;
+  }
+  return replay_run(sim, speedup);
+}
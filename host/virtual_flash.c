@@ -0,0 +1,71 @@
+#include "virtual_flash.h"
+#include <stdio.h>
+#include <string.h>
+
+void vflash_init(vflash_t *flash, const char *path) {
+  memset(flash, 0, sizeof(*flash));
+  memset(flash->data, 0xFF, sizeof(flash->data));
+  flash->path = path;
+
+  FILE *file = path ? fopen(path, "rb") : NULL;
+  if (file) {
+    size_t loaded = fread(flash->data, 1, sizeof(flash->data), file);
+    (void)loaded;
+    fclose(file);
+  }
+}
+
+// Regrava no arquivo apenas o trecho alterado
+static void vflash_persist(const vflash_t *flash, uint32_t offset, size_t len) {
+  if (!flash->path)
+    return;
+
+  FILE *file = fopen(flash->path, "r+b");
+  if (!file)
+    file = fopen(flash->path, "w+b");
+  if (!file)
+    return;
+
+  // Arquivo novo: grava a região inteira para manter os offsets
+  fseek(file, 0, SEEK_END);
+  if ((size_t)ftell(file) < sizeof(flash->data)) {
+    offset = 0;
+    len = sizeof(flash->data);
+  }
+
+  fseek(file, offset, SEEK_SET);
+  fwrite(&flash->data[offset], 1, len, file);
+  fclose(file);
+}
+
+void vflash_read(vflash_t *flash, uint32_t offset, void *dst, size_t len) {
+  if (offset + len > sizeof(flash->data))
+    return;
+
+  memcpy(dst, &flash->data[offset], len);
+  flash->read_bytes += len;
+}
+
+void vflash_erase(vflash_t *flash, uint32_t offset) {
+  offset -= offset % HAL_FLASH_SECTOR_SIZE;
+  if (offset >= sizeof(flash->data))
+    return;
+
+  memset(&flash->data[offset], 0xFF, HAL_FLASH_SECTOR_SIZE);
+  flash->erases[offset / HAL_FLASH_SECTOR_SIZE]++;
+  vflash_persist(flash, offset, HAL_FLASH_SECTOR_SIZE);
+}
+
+// A gravação só leva bits de 1 para 0; regravar sem apagar corrompe os dados, como no chip
+void vflash_program(vflash_t *flash, uint32_t offset, const void *src, size_t len) {
+  const uint8_t *bytes = src;
+
+  if (offset + len > sizeof(flash->data) || offset % HAL_FLASH_PAGE_SIZE || len % HAL_FLASH_PAGE_SIZE)
+    return;
+
+  for (size_t i = 0; i < len; ++i)
+    flash->data[offset + i] &= bytes[i];
+
+  flash->programmed_bytes += len;
+  vflash_persist(flash, offset, len);
+}
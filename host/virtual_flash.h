@@ -0,0 +1,30 @@
+#ifndef VIRTUAL_FLASH_H
+#define VIRTUAL_FLASH_H
+
+// Flash NOR virtual para a simulação, persistida em um arquivo: o apagamento leva um setor
+// a 0xFF e a gravação apenas zera bits, como no chip real. Conta apagamentos e bytes gravados
+// para medir a amplificação de escrita do registro de eventos.
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "hal.h"
+
+typedef struct {
+  const char *path;
+  uint8_t data[HAL_FLASH_LOG_SIZE];
+
+  // Estatísticas
+  uint32_t erases[HAL_FLASH_LOG_SECTORS];
+  uint32_t programmed_bytes;
+  uint32_t read_bytes;
+} vflash_t;
+
+// Carrega o conteúdo do arquivo (ou uma flash apagada, se ele não existir). Com path NULL a
+// flash fica apenas em RAM (testes).
+void vflash_init(vflash_t *flash, const char *path);
+void vflash_read(vflash_t *flash, uint32_t offset, void *dst, size_t len);
+void vflash_erase(vflash_t *flash, uint32_t offset);
+void vflash_program(vflash_t *flash, uint32_t offset, const void *src, size_t len);
+
+#endif
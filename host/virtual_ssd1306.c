@@ -0,0 +1,150 @@
+#include "virtual_ssd1306.h"
+#include <stdio.h>
+#include <string.h>
+
+void vssd1306_init(vssd1306_t *panel, uint8_t address) {
+  memset(panel, 0, sizeof(*panel));
+  panel->address = address;
+  panel->col_end = VSSD1306_WIDTH - 1;
+  panel->page_end = VSSD1306_PAGES - 1;
+  panel->mem_mode = 2; // Modo de página é o padrão após o reset
+  panel->contrast = 0x7F;
+}
+
+// Número de bytes de argumento de cada comando com parâmetros
+static uint8_t vssd1306_args_needed(uint8_t cmd) {
+  switch (cmd) {
+    case 0x21: // SET_COL_ADDR
+    case 0x22: // SET_PAGE_ADDR
+      return 2;
+    case 0x20: // SET_MEM_ADDR
+    case 0x81: // SET_CONTRAST
+    case 0x8D: // SET_CHARGE_PUMP
+    case 0xA8: // SET_MUX_RATIO
+    case 0xD3: // SET_DISP_OFFSET
+    case 0xD5: // SET_DISP_CLK_DIV
+    case 0xD9: // SET_PRECHARGE
+    case 0xDA: // SET_COM_PIN_CFG
+    case 0xDB: // SET_VCOM_DESEL
+      return 1;
+    default:
+      return 0;
+  }
+}
+
+static void vssd1306_execute(vssd1306_t *panel) {
+  uint8_t cmd = panel->cmd;
+
+  if (cmd == 0x20) {
+    panel->mem_mode = panel->args[0] & 0x03;
+  } else if (cmd == 0x21) {
+    panel->col_start = panel->args[0] & 0x7F;
+    panel->col_end = panel->args[1] & 0x7F;
+    panel->col = panel->col_start;
+  } else if (cmd == 0x22) {
+    panel->page_start = panel->args[0] & 0x07;
+    panel->page_end = panel->args[1] & 0x07;
+    panel->page = panel->page_start;
+  } else if (cmd == 0x81) {
+    panel->contrast = panel->args[0];
+  } else if (cmd == 0xAE || cmd == 0xAF) {
+    panel->display_on = cmd & 0x01;
+  } else if (cmd == 0xA6 || cmd == 0xA7) {
+    panel->inverted = cmd & 0x01;
+  } else if (panel->mem_mode == 2 && cmd >= 0xB0 && cmd <= 0xB7) {
+    panel->page = cmd & 0x07;
+  } else if (panel->mem_mode == 2 && cmd <= 0x0F) {
+    panel->col = (panel->col & 0xF0) | cmd;
+  } else if (panel->mem_mode == 2 && cmd >= 0x10 && cmd <= 0x17) {
+    panel->col = (panel->col & 0x0F) | ((cmd & 0x07) << 4);
+  }
+}
+
+static void vssd1306_command(vssd1306_t *panel, uint8_t byte) {
+  if (panel->nargs < panel->args_needed) {
+    panel->args[panel->nargs++] = byte;
+  } else {
+    panel->cmd = byte;
+    panel->nargs = 0;
+    panel->args_needed = vssd1306_args_needed(byte);
+  }
+
+  if (panel->nargs == panel->args_needed)
+    vssd1306_execute(panel);
+}
+
+// Grava um byte na GDDRAM e avança o ponteiro conforme o modo de endereçamento
+static void vssd1306_data(vssd1306_t *panel, uint8_t byte) {
+  panel->gddram[panel->page * VSSD1306_WIDTH + panel->col] = byte;
+  panel->data_bytes++;
+
+  if (panel->mem_mode == 1) {
+    if (panel->page++ >= panel->page_end) {
+      panel->page = panel->page_start;
+      panel->col = (panel->col >= panel->col_end) ? panel->col_start : panel->col + 1;
+    }
+  } else if (panel->mem_mode == 0) {
+    if (panel->col++ >= panel->col_end) {
+      panel->col = panel->col_start;
+      panel->page = (panel->page >= panel->page_end) ? panel->page_start : panel->page + 1;
+    }
+  } else if (panel->col < VSSD1306_WIDTH - 1) {
+    panel->col++;
+  }
+}
+
+// Decodifica uma transação I2C completa (START, endereço, bytes, STOP).
+// Byte de controle: bit 7 (Co) = apenas um byte a seguir, bit 6 (D/C#) = dados.
+void vssd1306_write(vssd1306_t *panel, const uint8_t *src, size_t len) {
+  panel->transactions++;
+  panel->bytes += len + 1;
+
+  size_t i = 0;
+  while (i < len) {
+    uint8_t control = src[i++];
+    bool is_data = control & 0x40;
+
+    if (control & 0x80) {
+      if (i < len) {
+        uint8_t byte = src[i++];
+        if (is_data)
+          vssd1306_data(panel, byte);
+        else
+          vssd1306_command(panel, byte);
+      }
+    } else {
+      for (; i < len; ++i) {
+        if (is_data)
+          vssd1306_data(panel, src[i]);
+        else
+          vssd1306_command(panel, src[i]);
+      }
+    }
+  }
+}
+
+bool vssd1306_get_pixel(const vssd1306_t *panel, uint8_t x, uint8_t y) {
+  if (x >= VSSD1306_WIDTH || y >= VSSD1306_HEIGHT)
+    return false;
+  bool on = panel->gddram[(y >> 3) * VSSD1306_WIDTH + x] & (1 << (y & 0b111));
+  return on != panel->inverted;
+}
+
+// Salva o conteúdo do painel como imagem PBM binária (P4, 1 = pixel aceso)
+bool vssd1306_dump_pbm(const vssd1306_t *panel, const char *path) {
+  FILE *file = fopen(path, "wb");
+  if (file == NULL)
+    return false;
+
+  fprintf(file, "P4\n%d %d\n", VSSD1306_WIDTH, VSSD1306_HEIGHT);
+  for (uint8_t y = 0; y < VSSD1306_HEIGHT; ++y) {
+    uint8_t row[VSSD1306_WIDTH / 8] = { 0 };
+    for (uint8_t x = 0; x < VSSD1306_WIDTH; ++x) {
+      if (panel->display_on && vssd1306_get_pixel(panel, x, y))
+        row[x >> 3] |= 0x80 >> (x & 0b111);
+    }
+    fwrite(row, 1, sizeof(row), file);
+  }
+
+  return fclose(file) == 0;
+}
@@ -0,0 +1,45 @@
+#ifndef VIRTUAL_SSD1306_H
+#define VIRTUAL_SSD1306_H
+
+// SSD1306 virtual para a simulação: decodifica as transações I2C (bytes de controle,
+// comandos e dados) e mantém a GDDRAM do controlador como um framebuffer.
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#define VSSD1306_WIDTH 128
+#define VSSD1306_PAGES 8
+#define VSSD1306_HEIGHT (VSSD1306_PAGES * 8)
+
+typedef struct {
+  uint8_t address;
+  uint8_t gddram[VSSD1306_PAGES * VSSD1306_WIDTH]; // Indexada por página * largura + coluna
+
+  // Endereçamento
+  uint8_t mem_mode;                 // 0 = horizontal, 1 = vertical, 2 = página
+  uint8_t col_start, col_end;
+  uint8_t page_start, page_end;
+  uint8_t col, page;
+
+  // Decodificação de comandos com argumentos
+  uint8_t cmd;
+  uint8_t args[2];
+  uint8_t nargs, args_needed;
+
+  bool display_on;
+  bool inverted;
+  uint8_t contrast;
+
+  // Estatísticas do barramento
+  uint32_t transactions;
+  uint32_t bytes;                   // Bytes no barramento, incluindo o byte de endereço
+  uint32_t data_bytes;              // Bytes gravados na GDDRAM
+} vssd1306_t;
+
+void vssd1306_init(vssd1306_t *panel, uint8_t address);
+void vssd1306_write(vssd1306_t *panel, const uint8_t *src, size_t len);
+bool vssd1306_get_pixel(const vssd1306_t *panel, uint8_t x, uint8_t y);
+bool vssd1306_dump_pbm(const vssd1306_t *panel, const char *path);
+
+#endif
@@ -68,10 +68,15 @@
  #define configSTACK_DEPTH_TYPE                  uint32_t
  #define configMESSAGE_BUFFER_LENGTH_TYPE        size_t
  
- /* Memory allocation related definitions. */
- #define configSUPPORT_STATIC_ALLOCATION         0
+ /* Memory allocation related definitions. Every kernel object of the application is
+    created with static storage; PARKING_STATIC_MEMORY (CMake option) also removes the heap. */
+ #define configSUPPORT_STATIC_ALLOCATION         1
+ #ifdef PARKING_STATIC_MEMORY
+ #define configSUPPORT_DYNAMIC_ALLOCATION        0
+ #else
  #define configSUPPORT_DYNAMIC_ALLOCATION        1
  #define configTOTAL_HEAP_SIZE                   (128*1024)
+ #endif
  #define configAPPLICATION_ALLOCATED_HEAP        0
  
  /* Hook function related definitions. */
@@ -80,10 +85,19 @@
  #define configUSE_DAEMON_TASK_STARTUP_HOOK      0
  
  /* Run time and task stats gathering related definitions. */
- #define configGENERATE_RUN_TIME_STATS           0
+ #define configGENERATE_RUN_TIME_STATS           1
  #define configUSE_TRACE_FACILITY                1
  #define configUSE_STATS_FORMATTING_FUNCTIONS    0
  
+ /* Run time stats use the free-running 1 us counter of the HAL (lib/hal.h), read as 64 bits:
+    a 32-bit count of microseconds wraps after ~71 minutes and corrupts the CPU percentages. */
+ #ifndef __ASSEMBLER__
+ extern uint64_t hal_time_us( void );
+ #endif
+ #define configRUN_TIME_COUNTER_TYPE             uint64_t
+ #define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()
+ #define portGET_RUN_TIME_COUNTER_VALUE()        hal_time_us()
+ 
  /* Co-routine related definitions. */
  #define configUSE_CO_ROUTINES                   0
  #define configMAX_CO_ROUTINE_PRIORITIES         1
@@ -101,8 +115,16 @@
  #define configMAX_API_CALL_INTERRUPT_PRIORITY   [dependent on processor and application]
  */
  
- /* SMP port only */
- #define configNUM_CORES                         1
+ /* SMP port only. PARKING_SMP (CMake option) runs the kernel on both RP2040 cores,
+    with the display task and the timer service task (buzzer sequencer) pinned to core 1
+    and gate tasks to core 0. Requires FreeRTOS-Kernel V11.1 or later (configNUMBER_OF_CORES
+    and the static memory hooks of main.c, including the passive idle task of core 1). */
+ #ifdef PARKING_SMP
+ #define configNUMBER_OF_CORES                   2
+ #define configUSE_CORE_AFFINITY                 1
+ #else
+ #define configNUMBER_OF_CORES                   1
+ #endif
  #define configTICK_CORE                         1
  #define configRUN_MULTIPLE_PRIORITIES           1
  
@@ -128,6 +150,7 @@
  #define INCLUDE_xTaskGetIdleTaskHandle          1
  #define INCLUDE_eTaskGetState                   1
  #define INCLUDE_xTimerPendFunctionCall          1
+ #define INCLUDE_xTimerGetTimerDaemonTaskHandle  1
  #define INCLUDE_xTaskAbortDelay                 1
  #define INCLUDE_xTaskGetHandle                  1
  #define INCLUDE_xTaskResumeFromISR              1
@@ -0,0 +1,81 @@
+#include "admission.h"
+#include "telemetry.h"
+#include "trace.h"
+
+void admission_init(admission_t *adm, parking_lot_t *lot, event_log_t *log) {
+  adm->lot = lot;
+  adm->log = log;
+  adm->free_spots = xSemaphoreCreateCountingStatic(lot->capacity, parking_lot_free(lot), &adm->free_spots_buffer);
+  adm->mutex = xSemaphoreCreateMutexStatic(&adm->mutex_buffer);
+}
+
+// A admissão é um único take no semáforo de contagem: nunca ultrapassa a capacidade total.
+// Com o take garantido há vaga livre em alguma zona; a vaga é escolhida sob o mutex das zonas.
+// Se mesmo assim não houver vaga, a ficha é devolvida e a entrada é recusada.
+bool admission_try_enter(admission_t *adm) {
+  if (xSemaphoreTake(adm->free_spots, 0) != pdTRUE)
+    return false;
+
+  parking_spot_t spot;
+  admission_lock(adm);
+  if (!parking_enter(adm->lot, PARKING_ZONE_ANY, &spot)) {
+    admission_unlock(adm);
+    xSemaphoreGive(adm->free_spots);
+    return false;
+  }
+  event_log_append(adm->log, EVENT_LOG_ENTER, spot);
+  telemetry_emit(TELEMETRY_SRC_PARKING, TELEMETRY_PARKING, EVENT_LOG_ENTER, spot.index, spot.zone,
+                 parking_lot_free(adm->lot));
+  admission_unlock(adm);
+  return true;
+}
+
+bool admission_try_leave(admission_t *adm) {
+  parking_spot_t spot;
+  admission_lock(adm);
+  bool left = parking_leave(adm->lot, PARKING_ZONE_ANY, &spot);
+  if (left) {
+    event_log_append(adm->log, EVENT_LOG_LEAVE, spot);
+    telemetry_emit(TELEMETRY_SRC_PARKING, TELEMETRY_PARKING, EVENT_LOG_LEAVE, spot.index, spot.zone,
+                   parking_lot_free(adm->lot));
+  }
+  admission_unlock(adm);
+
+  if (left)
+    xSemaphoreGive(adm->free_spots);
+  return left;
+}
+
+// Como as entradas e saídas, o reset só entra no buffer do registro: a flash é apagada e gravada
+// pela tarefa de gravação, sem o mutex das zonas. Devolve ao semáforo exatamente uma ficha por
+// carro removido, ainda sob o mutex: uma entrada que já tirou a sua ficha e aguarda o mutex
+// continua contabilizada, sem ultrapassar a capacidade.
+void admission_reset(admission_t *adm) {
+  parking_spot_t none = { 0 };
+  admission_lock(adm);
+  uint16_t removed = adm->lot->occupied;
+  parking_clear(adm->lot);
+  event_log_append(adm->log, EVENT_LOG_RESET, none);
+  telemetry_emit(TELEMETRY_SRC_PARKING, TELEMETRY_PARKING, EVENT_LOG_RESET, 0, 0, parking_lot_free(adm->lot));
+  for (uint16_t i = 0; i < removed; i++)
+    xSemaphoreGive(adm->free_spots);
+  admission_unlock(adm);
+}
+
+void admission_lock(admission_t *adm) {
+  uint32_t start_us = trace_now();
+  xSemaphoreTake(adm->mutex, portMAX_DELAY);
+  trace_record(TRACE_PARKING_MUTEX, start_us, trace_now());
+}
+
+bool admission_try_lock(admission_t *adm) {
+  return xSemaphoreTake(adm->mutex, 0) == pdTRUE;
+}
+
+void admission_unlock(admission_t *adm) {
+  xSemaphoreGive(adm->mutex);
+}
+
+uint16_t admission_free_tokens(admission_t *adm) {
+  return uxSemaphoreGetCount(adm->free_spots);
+}
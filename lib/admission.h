@@ -0,0 +1,43 @@
+#ifndef ADMISSION_H
+#define ADMISSION_H
+
+// Admissão de veículos sobre as zonas do estacionamento.
+// O semáforo de contagem guarda as vagas livres (entrada = take sem bloquear, saída = give) e o
+// mutex protege as zonas e o registro de eventos. A cada instante vale:
+//   fichas no semáforo + vagas ocupadas + entradas entre o take e a ocupação = capacidade
+
+#include "parking.h"
+#include "event_log.h"
+#include "FreeRTOS.h"
+#include "semphr.h"
+
+typedef struct {
+  parking_lot_t *lot;
+  event_log_t *log;
+  SemaphoreHandle_t free_spots;
+  SemaphoreHandle_t mutex;
+  StaticSemaphore_t free_spots_buffer;
+  StaticSemaphore_t mutex_buffer;
+} admission_t;
+
+// Cria o semáforo (iniciando com as vagas livres do estacionamento) e o mutex
+void admission_init(admission_t *adm, parking_lot_t *lot, event_log_t *log);
+
+// Ocupa uma vaga em qualquer zona; falha (sem bloquear) se o estacionamento estiver cheio
+bool admission_try_enter(admission_t *adm);
+
+// Libera uma vaga (na primeira zona com carro); falha se não houver carros estacionados
+bool admission_try_leave(admission_t *adm);
+
+// Libera todas as vagas
+void admission_reset(admission_t *adm);
+
+// Mutex das zonas: 'lock' registra a espera na etapa TRACE_PARKING_MUTEX; 'try_lock' não bloqueia
+void admission_lock(admission_t *adm);
+bool admission_try_lock(admission_t *adm);
+void admission_unlock(admission_t *adm);
+
+// Fichas disponíveis no semáforo (vagas livres ainda não reservadas por uma entrada)
+uint16_t admission_free_tokens(admission_t *adm);
+
+#endif
@@ -0,0 +1,113 @@
+#include "buzzer.h"
+#include "FreeRTOS.h"
+#include "timers.h"
+
+// Divisor inteiro (<= 255) e wrap de cada tom, calculados em tempo de compilação:
+// frequência = clock / (divisor * (wrap + 1)), com duty cycle de 50% (nível = wrap / 2)
+typedef struct {
+  uint8_t divider;
+  uint16_t wrap;
+} buzzer_tone_t;
+
+#define BUZZER_TONE(freq, div) { (div), BUZZER_PWM_CLOCK_HZ / ((div) * (freq)) - 1 }
+
+// O beep mantém os registradores que o cálculo anterior (para "60 Hz") de fato programava:
+// o divisor de 2083 era truncado para os 8 bits do divisor inteiro (35), resultando em ~3,57 kHz
+static const buzzer_tone_t buzzer_tones[BUZZER_TONE_COUNT] = {
+  [BUZZER_TONE_BEEP] = BUZZER_TONE(3571, 35),
+};
+
+// Estado do sequenciador: acessado apenas pela tarefa de serviço dos timers
+static uint buzzer_gpio;
+static TimerHandle_t buzzer_timer;
+static StaticTimer_t buzzer_timer_buffer;
+static const buzzer_pattern_t *queue[BUZZER_QUEUE_MAX];
+static uint8_t queue_head = 0, queue_count = 0;
+static const buzzer_pattern_t *current = NULL;
+static uint8_t remaining = 0;
+static bool sounding = false;
+
+// Pedidos descartados: fila de comandos dos timers cheia ou fila de padrões cheia
+static volatile uint32_t dropped = 0;
+
+// Agenda o próximo passo do padrão
+static void buzzer_arm(uint16_t ms) {
+  TickType_t ticks = pdMS_TO_TICKS(ms);
+  xTimerChangePeriod(buzzer_timer, ticks ? ticks : 1, 0);
+}
+
+static void buzzer_tone_on(void) {
+  const buzzer_tone_t *tone = &buzzer_tones[current->tone];
+
+  hal_pwm_config(buzzer_gpio, tone->divider, tone->wrap, tone->wrap / 2);
+  hal_pwm_enable(buzzer_gpio, true);
+  sounding = true;
+  buzzer_arm(current->on_ms);
+}
+
+// Inicia o próximo padrão da fila (ou fica ocioso)
+static void buzzer_next(void) {
+  if (queue_count == 0) {
+    current = NULL;
+    return;
+  }
+
+  current = queue[queue_head];
+  queue_head = (queue_head + 1) % BUZZER_QUEUE_MAX;
+  queue_count--;
+
+  remaining = current->repeat ? current->repeat : 1;
+  buzzer_tone_on();
+}
+
+// Callback do timer: fim do tempo ligado ou da pausa
+static void buzzer_step(TimerHandle_t timer) {
+  if (sounding) {
+    hal_pwm_enable(buzzer_gpio, false);
+    sounding = false;
+    remaining--;
+
+    if (current->off_ms > 0) {
+      buzzer_arm(current->off_ms);
+      return;
+    }
+  }
+
+  if (remaining > 0)
+    buzzer_tone_on();
+  else
+    buzzer_next();
+}
+
+// Executada na tarefa de serviço dos timers (xTimerPendFunctionCall): serializa os pedidos
+// com o callback do timer sem precisar de trava
+static void buzzer_enqueue(void *pattern, uint32_t unused) {
+  if (queue_count == BUZZER_QUEUE_MAX) {
+    dropped++;
+    return;
+  }
+
+  queue[(queue_head + queue_count) % BUZZER_QUEUE_MAX] = pattern;
+  queue_count++;
+
+  if (current == NULL)
+    buzzer_next();
+}
+
+void buzzer_init(uint gpio) {
+  buzzer_gpio = gpio;
+  hal_pwm_init(gpio);
+  buzzer_timer = xTimerCreateStatic("Buzzer", 1, pdFALSE, NULL, buzzer_step, &buzzer_timer_buffer);
+}
+
+bool buzzer_play(const buzzer_pattern_t *pattern) {
+  if (xTimerPendFunctionCall(buzzer_enqueue, (void *)pattern, 0, 0) != pdPASS) {
+    dropped++;
+    return false;
+  }
+  return true;
+}
+
+uint32_t buzzer_dropped(void) {
+  return dropped;
+}
@@ -0,0 +1,40 @@
+#ifndef BUZZER_H
+#define BUZZER_H
+
+// Sequenciador de sons do buzzer: padrões (tom, tempo ligado, tempo desligado, repetições)
+// tocados por um timer do FreeRTOS. Quem pede um som apenas enfileira o padrão e retorna.
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "hal.h"
+
+// Clock do PWM (clk_sys) usado no cálculo da tabela de tons
+#define BUZZER_PWM_CLOCK_HZ 125000000u
+
+// Padrões aguardando o fim do padrão em execução
+#define BUZZER_QUEUE_MAX 4
+
+// Tons disponíveis (índices da tabela de divisor/wrap)
+typedef enum {
+  BUZZER_TONE_BEEP, // ~3,57 kHz
+  BUZZER_TONE_COUNT
+} buzzer_tone_id_t;
+
+typedef struct {
+  uint8_t tone;
+  uint16_t on_ms;
+  uint16_t off_ms; // Pausa após cada repetição
+  uint8_t repeat;  // Número de vezes que o tom soa (>= 1)
+} buzzer_pattern_t;
+
+// Configura o PWM do pino (desligado) e o timer do sequenciador
+void buzzer_init(uint gpio);
+
+// Enfileira um padrão sem bloquear; 'pattern' deve permanecer válido (ex.: static const).
+// Retorna false se o pedido não pôde ser entregue ao sequenciador.
+bool buzzer_play(const buzzer_pattern_t *pattern);
+
+// Padrões descartados desde o boot (pedido não entregue ou fila de padrões cheia)
+uint32_t buzzer_dropped(void);
+
+#endif
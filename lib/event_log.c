@@ -0,0 +1,285 @@
+#include "event_log.h"
+#include <stddef.h>
+#include <string.h>
+
+#define EVENT_LOG_CRC_OFFSET offsetof(event_log_header_t, checkpoint_size)
+
+// CRC-32 (polinômio refletido 0xEDB88320), sem tabela para não ocupar RAM
+static uint32_t event_log_crc(const uint8_t *data, size_t len) {
+  uint32_t crc = ~0u;
+
+  for (size_t i = 0; i < len; ++i) {
+    crc ^= data[i];
+    for (uint8_t bit = 0; bit < 8; ++bit)
+      crc = (crc >> 1) ^ (0xEDB88320u & -(crc & 1u));
+  }
+  return ~crc;
+}
+
+static uint8_t *event_log_checkpoint(event_log_sector_t *sector) {
+  return (uint8_t *)sector->image + sizeof(event_log_header_t);
+}
+
+static event_log_record_t *event_log_records(event_log_t *log, event_log_sector_t *sector) {
+  return (event_log_record_t *)(event_log_checkpoint(sector) + log->checkpoint_size);
+}
+
+// Bytes da imagem em uso: cabeçalho, checkpoint e eventos
+static uint16_t event_log_used(const event_log_t *log, const event_log_sector_t *sector) {
+  return sizeof(event_log_header_t) + log->checkpoint_size + sector->records * sizeof(event_log_record_t);
+}
+
+// CRC do cabeçalho (a partir de checkpoint_size) e do checkpoint
+static uint32_t event_log_header_crc(const event_log_t *log, const event_log_sector_t *sector) {
+  return event_log_crc((const uint8_t *)sector->image + EVENT_LOG_CRC_OFFSET,
+                       sizeof(event_log_header_t) - EVENT_LOG_CRC_OFFSET + log->checkpoint_size);
+}
+
+// Inicia na imagem um setor novo com o checkpoint do estado atual das zonas (a flash só é
+// apagada pela tarefa de gravação)
+static void event_log_begin(event_log_t *log, event_log_sector_t *sector, uint8_t index) {
+  const parking_lot_t *lot = log->lot;
+  event_log_header_t *header = (event_log_header_t *)sector->image;
+  uint8_t *checkpoint = event_log_checkpoint(sector);
+
+  memset(sector->image, 0xFF, sizeof(sector->image));
+  for (uint8_t z = 0; z < lot->zone_count; z++) {
+    memcpy(checkpoint + z * sizeof(lot->zones[z].spots), lot->zones[z].spots, sizeof(lot->zones[z].spots));
+  }
+
+  header->magic = EVENT_LOG_MAGIC;
+  header->seq = ++log->seq;
+  header->checkpoint_size = log->checkpoint_size;
+  header->reserved = 0;
+  header->crc = event_log_header_crc(log, sector);
+
+  sector->sector = index;
+  sector->records = 0;
+  sector->flushed = 0;
+  sector->erased = false;
+  sector->sealed = false;
+}
+
+// Segue no outro buffer com o setor seguinte do anel; falha se a tarefa de gravação ainda não
+// terminou o setor cheio que ocupa esse buffer
+static bool event_log_rotate(event_log_t *log) {
+  event_log_sector_t *full = &log->sectors[log->active];
+  event_log_sector_t *next = &log->sectors[log->active ^ 1];
+
+  if (next->sealed)
+    return false;
+
+  event_log_begin(log, next, (full->sector + 1) % HAL_FLASH_LOG_SECTORS);
+  log->active ^= 1;
+  return true;
+}
+
+// Reaplica um evento; false se ele não foi gravado (bytes apagados) ou se a gravação foi
+// interrompida no meio dele
+static bool event_log_replay(parking_lot_t *lot, const event_log_record_t *record) {
+  parking_spot_t spot = { .zone = record->zone, .index = record->spot };
+
+  switch (record->type) {
+    case EVENT_LOG_ENTER:
+      parking_occupy(lot, spot);
+      return true;
+    case EVENT_LOG_LEAVE:
+      parking_release(lot, spot);
+      return true;
+    case EVENT_LOG_RESET:
+      parking_clear(lot);
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Valida o setor já lido na imagem e restaura as zonas a partir dele
+static bool event_log_restore(event_log_t *log, event_log_sector_t *sector) {
+  const event_log_header_t *header = (const event_log_header_t *)sector->image;
+  parking_lot_t *lot = log->lot;
+
+  if (header->checkpoint_size != log->checkpoint_size || header->crc != event_log_header_crc(log, sector))
+    return false;
+
+  // Checkpoint e, em seguida, os eventos gravados depois dele
+  const uint8_t *checkpoint = event_log_checkpoint(sector);
+  for (uint8_t z = 0; z < lot->zone_count; z++) {
+    memcpy(lot->zones[z].spots, checkpoint + z * sizeof(lot->zones[z].spots), sizeof(lot->zones[z].spots));
+  }
+  parking_init(lot, lot->zones, lot->zone_count);
+
+  const event_log_record_t *records = event_log_records(log, sector);
+  sector->records = 0;
+  while (sector->records < log->capacity && event_log_replay(lot, &records[sector->records])) {
+    sector->records++;
+  }
+
+  log->restored_records = sector->records;
+  return true;
+}
+
+// Bytes ainda apagados (0xFF)
+static bool event_log_blank(const uint8_t *data, size_t len) {
+  for (size_t i = 0; i < len; ++i) {
+    if (data[i] != 0xFF)
+      return false;
+  }
+  return true;
+}
+
+bool event_log_init(event_log_t *log, parking_lot_t *lot) {
+  log->lot = lot;
+  log->seq = 0;
+  log->active = 0;
+  log->checkpoint_size = lot->zone_count * sizeof(lot->zones[0].spots);
+  log->restored_records = 0;
+  log->appended_bytes = 0;
+  log->written_sectors = 0;
+  log->dropped = 0;
+  log->sectors[1].sealed = false;
+
+  if (sizeof(event_log_header_t) + log->checkpoint_size + sizeof(event_log_record_t) > HAL_FLASH_SECTOR_SIZE)
+    hal_panic("Checkpoint das zonas maior que um setor da flash");
+  log->capacity = (HAL_FLASH_SECTOR_SIZE - sizeof(event_log_header_t) - log->checkpoint_size) / sizeof(event_log_record_t);
+
+  log->mutex = xSemaphoreCreateMutexStatic(&log->mutex_buffer);
+  log->requests = xQueueCreateStatic(EVENT_LOG_QUEUE_LENGTH, sizeof(uint8_t), log->requests_storage,
+                                     &log->requests_buffer);
+
+  // Lê apenas os cabeçalhos e tenta os setores do mais recente para o mais antigo,
+  // descartando um setor cujo checkpoint não tenha sido gravado por inteiro (CRC inválido)
+  event_log_header_t headers[HAL_FLASH_LOG_SECTORS];
+  for (uint8_t i = 0; i < HAL_FLASH_LOG_SECTORS; i++) {
+    hal_flash_read(i * HAL_FLASH_SECTOR_SIZE, &headers[i], sizeof(headers[i]));
+    if (headers[i].magic == EVENT_LOG_MAGIC && headers[i].seq > log->seq)
+      log->seq = headers[i].seq;
+  }
+
+  event_log_sector_t *sector = &log->sectors[0];
+  bool restored = false;
+  uint8_t next = 0;
+  uint32_t below = UINT32_MAX;
+  while (!restored) {
+    int newest = -1;
+    for (uint8_t i = 0; i < HAL_FLASH_LOG_SECTORS; i++) {
+      if (headers[i].magic == EVENT_LOG_MAGIC && headers[i].seq < below &&
+          (newest < 0 || headers[i].seq > headers[newest].seq))
+        newest = i;
+    }
+    if (newest < 0)
+      break;
+
+    hal_flash_read(newest * HAL_FLASH_SECTOR_SIZE, sector->image, HAL_FLASH_SECTOR_SIZE);
+    restored = event_log_restore(log, sector);
+    below = headers[newest].seq;
+    sector->sector = newest;
+
+    // Um setor novo substitui os mais novos que o restaurado (corrompidos, se houver)
+    next = (newest + 1) % HAL_FLASH_LOG_SECTORS;
+  }
+
+  // Continua no setor restaurado se o restante dele ainda estiver apagado; cheio ou com um
+  // evento de gravação interrompida, os eventos seguem em um setor novo
+  uint16_t used = restored ? event_log_used(log, sector) : HAL_FLASH_SECTOR_SIZE;
+  if (restored && sector->records < log->capacity &&
+      event_log_blank((const uint8_t *)sector->image + used, HAL_FLASH_SECTOR_SIZE - used)) {
+    sector->flushed = used;
+    sector->erased = true;
+    sector->sealed = false;
+  } else {
+    event_log_begin(log, sector, next);
+  }
+  return restored;
+}
+
+void event_log_append(event_log_t *log, event_log_type_t type, parking_spot_t spot) {
+  event_log_record_t record = {
+    .time_ms = hal_time_ms(),
+    .type = type,
+    .zone = spot.zone,
+    .spot = spot.index
+  };
+
+  xSemaphoreTake(log->mutex, portMAX_DELAY);
+
+  // Setor que não pôde ser trocado ao encher: o checkpoint do novo já inclui este evento, e
+  // reaplicá-lo na recuperação não altera as zonas
+  if (log->sectors[log->active].records == log->capacity && !event_log_rotate(log)) {
+    log->dropped++;
+    xSemaphoreGive(log->mutex);
+    return;
+  }
+
+  event_log_sector_t *sector = &log->sectors[log->active];
+  event_log_records(log, sector)[sector->records++] = record;
+  log->appended_bytes += sizeof(record);
+
+  bool full = sector->records == log->capacity;
+  if (full) {
+    sector->sealed = true;
+    event_log_rotate(log);
+  }
+  xSemaphoreGive(log->mutex);
+
+  if (full) {
+    uint8_t request = EVENT_LOG_REQUEST_SECTOR;
+    xQueueSend(log->requests, &request, 0);
+  }
+}
+
+void event_log_sync(event_log_t *log) {
+  uint8_t request = EVENT_LOG_REQUEST_SYNC;
+  xQueueSend(log->requests, &request, 0); // Fila cheia: a gravação já foi pedida
+}
+
+// Grava a próxima página pendente: primeiro a do setor cheio, se houver, depois a do setor em
+// montagem. A página é copiada sob o mutex e gravada sem ele (apagando antes o setor, se for o
+// início da imagem); uma página já gravada em parte é regravada com os mesmos bytes, que a flash
+// mantém. Retorna false se não houver nada pendente.
+static bool event_log_flush_page(event_log_t *log) {
+  xSemaphoreTake(log->mutex, portMAX_DELAY);
+  event_log_sector_t *sector = &log->sectors[log->active ^ 1];
+  if (!sector->sealed)
+    sector = &log->sectors[log->active];
+
+  uint16_t used = event_log_used(log, sector);
+  if (sector->flushed >= used) {
+    xSemaphoreGive(log->mutex);
+    return false;
+  }
+
+  uint16_t start = sector->flushed - sector->flushed % HAL_FLASH_PAGE_SIZE;
+  uint16_t end = used < start + HAL_FLASH_PAGE_SIZE ? used : start + HAL_FLASH_PAGE_SIZE;
+  uint32_t offset = sector->sector * HAL_FLASH_SECTOR_SIZE;
+  bool erase = !sector->erased;
+  memcpy(log->page, (const uint8_t *)sector->image + start, HAL_FLASH_PAGE_SIZE);
+  xSemaphoreGive(log->mutex);
+
+  if (erase)
+    hal_flash_erase(offset);
+  hal_flash_program(offset + start, log->page, HAL_FLASH_PAGE_SIZE);
+
+  // O buffer não é reutilizado enquanto estiver selado, e os eventos novos só vão além de 'used'
+  xSemaphoreTake(log->mutex, portMAX_DELAY);
+  sector->flushed = end;
+  sector->erased = true;
+  if (erase)
+    log->written_sectors++;
+  if (sector->sealed && sector->flushed == event_log_used(log, sector))
+    sector->sealed = false;
+  xSemaphoreGive(log->mutex);
+  return true;
+}
+
+bool event_log_process(event_log_t *log, TickType_t timeout) {
+  uint8_t request;
+
+  if (xQueueReceive(log->requests, &request, timeout) != pdTRUE)
+    return false;
+
+  // Os pedidos se acumulam: qualquer um grava tudo o que estiver pendente
+  while (event_log_flush_page(log)) {
+  }
+  return true;
+}
@@ -0,0 +1,108 @@
+#ifndef EVENT_LOG_H
+#define EVENT_LOG_H
+
+// Registro persistente dos eventos de ocupação na flash.
+// Os eventos são acumulados em RAM, na imagem do setor em montagem, e gravados por uma tarefa
+// própria (event_log_process): quem registra um evento não apaga nem grava a flash. Cada setor
+// é preenchido até o fim antes do próximo, em anel sobre os HAL_FLASH_LOG_SECTORS setores da
+// região (cada setor é apagado uma vez por volta); a gravação periódica apenas grava as páginas
+// com eventos novos do mesmo setor, já apagado.
+// Cada setor começa com um checkpoint (bitmaps das zonas) seguido dos eventos posteriores:
+// no boot basta restaurar o checkpoint do setor mais recente e reaplicar os seus eventos.
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "hal.h"
+#include "parking.h"
+#include "FreeRTOS.h"
+#include "queue.h"
+#include "semphr.h"
+
+#define EVENT_LOG_MAGIC 0x4C4B5250u // "PRKL"
+#define EVENT_LOG_QUEUE_LENGTH 4
+
+typedef enum {
+  EVENT_LOG_ENTER = 1,
+  EVENT_LOG_LEAVE = 2,
+  EVENT_LOG_RESET = 3
+} event_log_type_t;
+
+// Um evento ainda não gravado fica com os bytes apagados (tipo 0xFF)
+typedef struct {
+  uint32_t time_ms;
+  uint8_t type;
+  uint8_t zone;
+  uint16_t spot;
+} event_log_record_t;
+
+// Cabeçalho de cada setor, gravado junto com o checkpoint na primeira página; o CRC cobre o
+// restante do cabeçalho e o checkpoint (os eventos são acrescentados depois)
+typedef struct {
+  uint32_t magic;
+  uint32_t seq;
+  uint32_t crc;
+  uint16_t checkpoint_size;
+  uint16_t reserved;
+} event_log_header_t;
+
+// Pedidos à tarefa de gravação
+typedef enum {
+  EVENT_LOG_REQUEST_SYNC,  // Gravação periódica das páginas com eventos novos
+  EVENT_LOG_REQUEST_SECTOR // Setor cheio: grava o restante e libera o buffer
+} event_log_request_t;
+
+// Imagem em RAM de um setor. 'records' é alterado por quem registra os eventos; 'flushed',
+// 'erased' e 'sealed' (ao liberar) apenas pela tarefa de gravação, sempre sob o mutex do registro
+typedef struct {
+  uint32_t image[HAL_FLASH_SECTOR_SIZE / sizeof(uint32_t)];
+  uint8_t sector;    // Setor da flash
+  uint16_t records;  // Eventos na imagem
+  uint16_t flushed;  // Bytes da imagem já gravados na flash
+  bool erased;       // Setor já apagado para esta imagem
+  bool sealed;       // Cheio: aguarda a gravação do restante antes de ser reutilizado
+} event_log_sector_t;
+
+typedef struct {
+  parking_lot_t *lot;
+  uint32_t seq;          // Sequência do setor em montagem
+  uint16_t capacity;     // Eventos por setor
+  uint16_t checkpoint_size;
+
+  // Dois buffers: o setor cheio é gravado pela tarefa enquanto os eventos seguem no outro
+  event_log_sector_t sectors[2];
+  uint8_t active;
+
+  SemaphoreHandle_t mutex;   // Protege os buffers (nunca fica retido durante o acesso à flash)
+  QueueHandle_t requests;    // Pedidos à tarefa de gravação
+  StaticSemaphore_t mutex_buffer;
+  StaticQueue_t requests_buffer;
+  uint8_t requests_storage[EVENT_LOG_QUEUE_LENGTH * sizeof(uint8_t)];
+  uint32_t page[HAL_FLASH_PAGE_SIZE / sizeof(uint32_t)]; // Cópia da página em gravação
+
+  // Resultado da recuperação e estatísticas
+  uint16_t restored_records;
+  uint32_t appended_bytes;
+  uint32_t written_sectors;  // Setores apagados e iniciados na flash
+  uint32_t dropped;          // Eventos perdidos com os dois buffers cheios
+} event_log_t;
+
+// Restaura o estado das zonas a partir da flash (se houver registro válido) e prepara o buffer,
+// continuando no setor restaurado se ainda houver espaço. Deve ser chamada após parking_init e
+// antes do escalonador. Retorna true se o estado foi restaurado.
+bool event_log_init(event_log_t *log, parking_lot_t *lot);
+
+// Acrescenta um evento ao buffer (apenas RAM, sem bloquear na flash). Chamada sob o mutex das
+// zonas, que garante que o checkpoint de um setor novo corresponda aos eventos registrados.
+// Com o setor cheio, pede a sua gravação à tarefa e segue no outro buffer; se este ainda não
+// tiver sido gravado, o evento é descartado e contado em 'dropped'.
+void event_log_append(event_log_t *log, event_log_type_t type, parking_spot_t spot);
+
+// Pede à tarefa de gravação que grave os eventos pendentes (não bloqueia; pode ser chamada de
+// um callback de timer)
+void event_log_sync(event_log_t *log);
+
+// Corpo da tarefa de gravação: aguarda um pedido por até 'timeout' e grava todas as páginas
+// pendentes, apagando o setor quando ele é iniciado. Retorna false se nenhum pedido chegou.
+bool event_log_process(event_log_t *log, TickType_t timeout);
+
+#endif
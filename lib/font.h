@@ -1,4 +1,4 @@
-static uint8_t font[] = {
+static const uint8_t font[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, //
   0x00, 0x00, 0x00, 0x5F, 0x5F, 0x00, 0x00, 0x00, // !
   0x00, 0x07, 0x07, 0x00, 0x07, 0x07, 0x00, 0x00, // "
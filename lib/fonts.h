@@ -0,0 +1,28 @@
+#ifndef FONTS_H
+#define FONTS_H
+
+// Fontes do display. Os glifos são colunas de até 8 linhas (bit 0 = linha superior), o mesmo
+// formato da RAM do SSD1306. Fontes proporcionais guardam apenas as colunas usadas de cada
+// glifo, empacotadas, e o início de cada glifo em 'offsets'.
+
+#include <stdint.h>
+
+typedef struct {
+  char first, last;        // Faixa de caracteres (os demais são desenhados como 'first')
+  uint8_t height;          // Linhas de cada glifo (<= 8)
+  uint8_t width;           // Largura fixa (ou a maior largura, nas fontes proporcionais)
+  uint8_t spacing;         // Colunas em branco após cada glifo
+  const uint8_t *columns;  // Colunas dos glifos
+  const uint16_t *offsets; // Início de cada glifo e, no fim, o total (NULL = largura fixa)
+} ssd1306_font_t;
+
+extern const ssd1306_font_t font_8x8; // Fonte original 8x8, largura fixa
+extern const ssd1306_font_t font_5x7; // Fonte compacta proporcional, para texto denso
+
+// Colunas e largura do glifo de 'c'
+uint8_t font_glyph(const ssd1306_font_t *font, char c, const uint8_t **columns);
+
+// Largura em pixels de 'str' na escala indicada (incluindo o espaçamento após cada glifo)
+uint16_t font_text_width(const ssd1306_font_t *font, const char *str, uint8_t scale);
+
+#endif
@@ -0,0 +1,89 @@
+#ifndef HAL_H
+#define HAL_H
+
+// Camada fina de abstração de hardware (GPIO, PWM, I2C e tempo).
+// A implementação para a placa fica em lib/hal_pico.c e a da simulação em host/hal_host.c.
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef PARKING_HOST_BUILD
+typedef unsigned int uint;
+typedef uint8_t hal_i2c_t;
+#define HAL_I2C0 0
+#define HAL_I2C1 1
+#else
+#include "pico/stdlib.h"
+#include "hardware/i2c.h"
+typedef i2c_inst_t *hal_i2c_t;
+#define HAL_I2C0 i2c0
+#define HAL_I2C1 i2c1
+#endif
+
+// Eventos de borda das interrupções de GPIO (mesmos valores do SDK do RP2040)
+#define HAL_GPIO_EDGE_FALL 0x4u
+#define HAL_GPIO_EDGE_RISE 0x8u
+
+// Bit de STOP de uma palavra de fluxo I2C (mesmo formato do registrador IC_DATA_CMD)
+#define HAL_I2C_STOP 0x200u
+
+// Região da flash reservada ao registro de eventos (últimos setores da flash)
+#define HAL_FLASH_SECTOR_SIZE 4096u
+#define HAL_FLASH_PAGE_SIZE 256u
+#define HAL_FLASH_LOG_SECTORS 16u
+#define HAL_FLASH_LOG_SIZE (HAL_FLASH_LOG_SECTORS * HAL_FLASH_SECTOR_SIZE)
+
+typedef void (*hal_gpio_irq_t)(uint gpio, uint32_t events);
+typedef void (*hal_i2c_stream_done_t)(void *ctx);
+
+// Sistema
+void hal_init(void);
+void hal_panic(const char *message);
+
+// Tempo desde o boot
+uint32_t hal_time_ms(void);
+uint64_t hal_time_us(void);
+uint32_t hal_time_us32(void); // Leitura única do contador de 1 us (marcação de tempo em ISRs)
+
+// Console (USB CDC na placa): próximo caractere recebido ou -1 se não houver
+int hal_console_getchar(void);
+
+// Bytes da telemetria binária, sem conversão de fim de linha (USB CDC na placa)
+void hal_telemetry_write(const uint8_t *data, size_t len);
+
+// GPIO
+void hal_gpio_input_pullup(uint gpio);
+void hal_gpio_output(uint gpio);
+void hal_gpio_put(uint gpio, bool value);
+bool hal_gpio_get(uint gpio);
+void hal_gpio_irq_enable(uint gpio, uint32_t events, hal_gpio_irq_t callback);
+void hal_gpio_irq_set_enabled(uint gpio, uint32_t events, bool enabled);
+
+// PWM (um canal por pino)
+void hal_pwm_init(uint gpio);
+void hal_pwm_config(uint gpio, uint32_t divider, uint32_t wrap, uint32_t level);
+void hal_pwm_enable(uint gpio, bool enabled);
+
+// I2C bloqueante
+void hal_i2c_init(hal_i2c_t port, uint baudrate, uint sda, uint scl);
+int hal_i2c_write(hal_i2c_t port, uint8_t address, const uint8_t *src, size_t len);
+void hal_i2c_wait_idle(hal_i2c_t port);
+
+// I2C assíncrono: palavras de 16 bits (byte | HAL_I2C_STOP) enviadas sem ocupar a CPU.
+// 'done' é chamado em contexto de interrupção quando a última palavra foi entregue.
+// 'hal_i2c_stream_wait' bloqueia a tarefa até o próximo término do fluxo (sinalizado na mesma
+// interrupção, depois de 'done'); um término que ninguém aguardou faz a próxima espera retornar
+// de imediato, então quem espera confere de novo o próprio estado.
+int hal_i2c_stream_claim(hal_i2c_t port);
+void hal_i2c_stream_start(int stream, uint8_t address, const uint16_t *words, size_t count,
+                          hal_i2c_stream_done_t done, void *ctx);
+void hal_i2c_stream_wait(int stream);
+
+// Flash do registro de eventos. Offsets relativos ao início da região; 'erase' apaga um setor
+// (bytes = 0xFF) e 'program' grava páginas inteiras já apagadas.
+void hal_flash_read(uint32_t offset, void *dst, size_t len);
+void hal_flash_erase(uint32_t offset);
+void hal_flash_program(uint32_t offset, const void *src, size_t len);
+
+#endif
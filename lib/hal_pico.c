@@ -0,0 +1,231 @@
+#include "hal.h"
+#include "hardware/pwm.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "hardware/flash.h"
+#include "pico/flash.h"
+#include "pico/stdio_usb.h"
+#include "FreeRTOS.h"
+#include "semphr.h"
+#include <stdio.h>
+#include <string.h>
+
+// Estado de cada canal DMA usado como fluxo I2C
+typedef struct {
+  i2c_inst_t *port;
+  hal_i2c_stream_done_t done;
+  void *ctx;
+  SemaphoreHandle_t finished; // Dado a cada término (hal_i2c_stream_wait)
+  StaticSemaphore_t finished_buffer;
+} hal_stream_t;
+
+static hal_stream_t streams[NUM_DMA_CHANNELS];
+static bool dma_irq_installed = false;
+static uint gpio_irq_core = 0;
+
+void hal_init(void) {
+  stdio_init_all();
+}
+
+void hal_panic(const char *message) {
+  panic("%s", message);
+}
+
+uint32_t hal_time_ms(void) {
+  return to_ms_since_boot(get_absolute_time());
+}
+
+uint64_t hal_time_us(void) {
+  return time_us_64();
+}
+
+uint32_t hal_time_us32(void) {
+  return time_us_32();
+}
+
+int hal_console_getchar(void) {
+  int c = getchar_timeout_us(0);
+  return c == PICO_ERROR_TIMEOUT ? -1 : c;
+}
+
+// Escreve direto no driver USB do stdio: uma única chamada (o quadro não se mistura com o
+// texto do printf) e sem a conversão de '\n' para "\r\n"
+void hal_telemetry_write(const uint8_t *data, size_t len) {
+  stdio_usb.out_chars((const char *)data, (int)len);
+}
+
+void hal_gpio_input_pullup(uint gpio) {
+  gpio_init(gpio);
+  gpio_set_dir(gpio, GPIO_IN);
+  gpio_pull_up(gpio);
+}
+
+void hal_gpio_output(uint gpio) {
+  gpio_init(gpio);
+  gpio_set_dir(gpio, GPIO_OUT);
+}
+
+void hal_gpio_put(uint gpio, bool value) {
+  gpio_put(gpio, value);
+}
+
+bool hal_gpio_get(uint gpio) {
+  return gpio_get(gpio);
+}
+
+// O SDK mantém um único callback para todos os pinos do núcleo. O núcleo que registra o
+// callback é o que atende as interrupções dos botões.
+void hal_gpio_irq_enable(uint gpio, uint32_t events, hal_gpio_irq_t callback) {
+  gpio_irq_core = get_core_num();
+  gpio_set_irq_enabled_with_callback(gpio, events, true, callback);
+}
+
+// Habilitar novamente descarta as bordas registradas enquanto o pino estava desabilitado.
+// gpio_set_irq_enabled altera o núcleo que a chama; aqui o registrador usado é sempre o do
+// núcleo que atende as interrupções (o timer de debounce pode rodar no outro núcleo no modo SMP).
+void hal_gpio_irq_set_enabled(uint gpio, uint32_t events, bool enabled) {
+  io_rw_32 *inte = gpio_irq_core ? &io_bank0_hw->proc1_irq_ctrl.inte[gpio / 8]
+                                 : &io_bank0_hw->proc0_irq_ctrl.inte[gpio / 8];
+  uint32_t mask = events << (4 * (gpio % 8));
+
+  if (enabled) {
+    gpio_acknowledge_irq(gpio, events);
+    hw_set_bits(inte, mask);
+  } else {
+    hw_clear_bits(inte, mask);
+  }
+}
+
+void hal_pwm_init(uint gpio) {
+  gpio_set_function(gpio, GPIO_FUNC_PWM);
+  uint slice = pwm_gpio_to_slice_num(gpio);
+
+  pwm_config config = pwm_get_default_config();
+  pwm_init(slice, &config, false);
+}
+
+void hal_pwm_config(uint gpio, uint32_t divider, uint32_t wrap, uint32_t level) {
+  uint slice = pwm_gpio_to_slice_num(gpio);
+  pwm_set_clkdiv_int_frac(slice, divider, 0);
+  pwm_set_wrap(slice, wrap);
+  pwm_set_chan_level(slice, pwm_gpio_to_channel(gpio), level);
+}
+
+void hal_pwm_enable(uint gpio, bool enabled) {
+  pwm_set_enabled(pwm_gpio_to_slice_num(gpio), enabled);
+}
+
+void hal_i2c_init(hal_i2c_t port, uint baudrate, uint sda, uint scl) {
+  i2c_init(port, baudrate);
+
+  gpio_set_function(sda, GPIO_FUNC_I2C);
+  gpio_set_function(scl, GPIO_FUNC_I2C);
+  gpio_pull_up(sda);
+  gpio_pull_up(scl);
+}
+
+int hal_i2c_write(hal_i2c_t port, uint8_t address, const uint8_t *src, size_t len) {
+  return i2c_write_blocking(port, address, src, len, false);
+}
+
+// Aguarda a FIFO TX esvaziar e o controlador concluir o último byte (STOP)
+void hal_i2c_wait_idle(hal_i2c_t port) {
+  i2c_hw_t *hw = i2c_get_hw(port);
+  while (!(hw->status & I2C_IC_STATUS_TFE_BITS) || (hw->status & I2C_IC_STATUS_ACTIVITY_BITS))
+    tight_loop_contents();
+}
+
+// Tratador compartilhado da interrupção DMA_IRQ_0: notifica o término de cada fluxo
+static void hal_dma_irq_handler(void) {
+  BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+  for (uint channel = 0; channel < NUM_DMA_CHANNELS; ++channel) {
+    if (streams[channel].port == NULL || !dma_channel_get_irq0_status(channel))
+      continue;
+
+    dma_channel_acknowledge_irq0(channel);
+    if (streams[channel].done)
+      streams[channel].done(streams[channel].ctx);
+    xSemaphoreGiveFromISR(streams[channel].finished, &xHigherPriorityTaskWoken);
+  }
+
+  portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+
+// Reserva um canal DMA que alimenta a FIFO TX do I2C (registrador IC_DATA_CMD)
+int hal_i2c_stream_claim(hal_i2c_t port) {
+  int channel = dma_claim_unused_channel(true);
+
+  dma_channel_config config = dma_channel_get_default_config(channel);
+  channel_config_set_transfer_data_size(&config, DMA_SIZE_16);
+  channel_config_set_read_increment(&config, true);
+  channel_config_set_write_increment(&config, false);
+  channel_config_set_dreq(&config, i2c_get_dreq(port, true));
+  dma_channel_configure(channel, &config, &i2c_get_hw(port)->data_cmd, NULL, 0, false);
+
+  streams[channel].port = port;
+  streams[channel].finished = xSemaphoreCreateBinaryStatic(&streams[channel].finished_buffer);
+
+  if (!dma_irq_installed) {
+    irq_add_shared_handler(DMA_IRQ_0, hal_dma_irq_handler, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    irq_set_enabled(DMA_IRQ_0, true);
+    dma_irq_installed = true;
+  }
+  dma_channel_set_irq0_enabled(channel, true);
+
+  return channel;
+}
+
+void hal_i2c_stream_start(int stream, uint8_t address, const uint16_t *words, size_t count,
+                          hal_i2c_stream_done_t done, void *ctx) {
+  i2c_hw_t *hw = i2c_get_hw(streams[stream].port);
+  hw->enable = 0;
+  hw->tar = address;
+  hw->enable = I2C_IC_ENABLE_ENABLE_BITS;
+
+  streams[stream].done = done;
+  streams[stream].ctx = ctx;
+  dma_channel_transfer_from_buffer_now(stream, words, count);
+}
+
+void hal_i2c_stream_wait(int stream) {
+  xSemaphoreTake(streams[stream].finished, portMAX_DELAY);
+}
+
+// Início da região do registro: últimos HAL_FLASH_LOG_SIZE bytes da flash
+#define HAL_FLASH_LOG_OFFSET (PICO_FLASH_SIZE_BYTES - HAL_FLASH_LOG_SIZE)
+
+// A leitura é feita pelo mapeamento XIP da flash
+void hal_flash_read(uint32_t offset, void *dst, size_t len) {
+  memcpy(dst, (const void *)(XIP_BASE + HAL_FLASH_LOG_OFFSET + offset), len);
+}
+
+// Durante apagamento/gravação o XIP fica indisponível: flash_safe_execute desabilita as
+// interrupções e, no modo SMP, pausa o outro núcleo enquanto a operação é executada
+typedef struct {
+  uint32_t offset;
+  const void *src;
+  size_t len;
+} hal_flash_op_t;
+
+static void hal_flash_erase_op(void *param) {
+  const hal_flash_op_t *op = param;
+  flash_range_erase(HAL_FLASH_LOG_OFFSET + op->offset, HAL_FLASH_SECTOR_SIZE);
+}
+
+static void hal_flash_program_op(void *param) {
+  const hal_flash_op_t *op = param;
+  flash_range_program(HAL_FLASH_LOG_OFFSET + op->offset, op->src, op->len);
+}
+
+void hal_flash_erase(uint32_t offset) {
+  hal_flash_op_t op = { .offset = offset };
+  if (flash_safe_execute(hal_flash_erase_op, &op, UINT32_MAX) != PICO_OK)
+    hal_panic("Falha ao apagar a flash");
+}
+
+void hal_flash_program(uint32_t offset, const void *src, size_t len) {
+  hal_flash_op_t op = { .offset = offset, .src = src, .len = len };
+  if (flash_safe_execute(hal_flash_program_op, &op, UINT32_MAX) != PICO_OK)
+    hal_panic("Falha ao gravar a flash");
+}
@@ -0,0 +1,179 @@
+#include "parking.h"
+#include <string.h>
+
+// Bits da palavra 'word' que ficam além da capacidade da zona (nunca são vagas)
+static uint32_t parking_pad_mask(const parking_zone_t *zone, uint32_t word) {
+  uint32_t first = word * PARKING_WORD_BITS;
+
+  if (first + PARKING_WORD_BITS <= zone->capacity)
+    return 0;
+  if (first >= zone->capacity)
+    return ~0u;
+  return ~0u << (zone->capacity - first);
+}
+
+// Recalcula os bits de resumo de uma palavra após ocupar/liberar uma vaga
+static void parking_update_summary(parking_zone_t *zone, uint32_t word) {
+  uint32_t bit = 1u << word;
+
+  if ((zone->spots[word] | parking_pad_mask(zone, word)) == ~0u)
+    zone->full |= bit;
+  else
+    zone->full &= ~bit;
+
+  if (zone->spots[word] != 0)
+    zone->used |= bit;
+  else
+    zone->used &= ~bit;
+}
+
+static bool parking_spot_valid(const parking_lot_t *lot, parking_spot_t spot) {
+  return spot.zone < lot->zone_count && spot.index < lot->zones[spot.zone].capacity;
+}
+
+bool parking_init(parking_lot_t *lot, parking_zone_t *zones, uint8_t zone_count) {
+  lot->zones = zones;
+  lot->zone_count = 0;
+  lot->capacity = 0;
+  lot->occupied = 0;
+
+  // Zonas além dos bitmaps ou capacidade total acima do contador: estacionamento vazio, sem vagas
+  uint32_t capacity = 0;
+  for (uint8_t z = 0; z < zone_count; z++) {
+    if (zones[z].capacity > PARKING_ZONE_MAX_SPOTS)
+      return false;
+    capacity += zones[z].capacity;
+  }
+  if (capacity > UINT16_MAX)
+    return false;
+
+  lot->zone_count = zone_count;
+  for (uint8_t z = 0; z < zone_count; z++) {
+    parking_zone_t *zone = &zones[z];
+
+    // Palavras inexistentes ficam marcadas como cheias para nunca serem escolhidas
+    zone->full = PARKING_ZONE_WORDS < PARKING_WORD_BITS ? ~0u << PARKING_ZONE_WORDS : 0;
+    zone->used = 0;
+
+    for (uint32_t w = 0; w < PARKING_ZONE_WORDS; w++) {
+      zone->spots[w] &= ~parking_pad_mask(zone, w);
+      parking_update_summary(zone, w);
+    }
+
+    zone->occupied = parking_zone_count(zone);
+    lot->capacity += zone->capacity;
+    lot->occupied += zone->occupied;
+  }
+  return true;
+}
+
+bool parking_enter(parking_lot_t *lot, uint8_t zone_id, parking_spot_t *spot) {
+  // Sem zona definida: primeira zona com vaga livre
+  if (zone_id == PARKING_ZONE_ANY) {
+    for (zone_id = 0; zone_id < lot->zone_count; zone_id++) {
+      if (lot->zones[zone_id].occupied < lot->zones[zone_id].capacity)
+        break;
+    }
+  }
+  if (zone_id >= lot->zone_count)
+    return false;
+
+  parking_zone_t *zone = &lot->zones[zone_id];
+  if (zone->occupied >= zone->capacity)
+    return false;
+
+  // Primeira palavra com vaga livre e, nela, o primeiro bit livre
+  uint32_t word = __builtin_ctz(~zone->full);
+  uint32_t bit = __builtin_ctz(~(zone->spots[word] | parking_pad_mask(zone, word)));
+
+  zone->spots[word] |= 1u << bit;
+  parking_update_summary(zone, word);
+  zone->occupied++;
+  lot->occupied++;
+
+  if (spot) {
+    spot->zone = zone_id;
+    spot->index = word * PARKING_WORD_BITS + bit;
+  }
+  return true;
+}
+
+bool parking_leave(parking_lot_t *lot, uint8_t zone_id, parking_spot_t *spot) {
+  // Sem zona definida: primeira zona com vaga ocupada
+  if (zone_id == PARKING_ZONE_ANY) {
+    for (zone_id = 0; zone_id < lot->zone_count; zone_id++) {
+      if (lot->zones[zone_id].occupied > 0)
+        break;
+    }
+  }
+  if (zone_id >= lot->zone_count)
+    return false;
+
+  parking_zone_t *zone = &lot->zones[zone_id];
+  if (zone->occupied == 0)
+    return false;
+
+  uint32_t word = __builtin_ctz(zone->used);
+  uint32_t bit = __builtin_ctz(zone->spots[word]);
+
+  zone->spots[word] &= ~(1u << bit);
+  parking_update_summary(zone, word);
+  zone->occupied--;
+  lot->occupied--;
+
+  if (spot) {
+    spot->zone = zone_id;
+    spot->index = word * PARKING_WORD_BITS + bit;
+  }
+  return true;
+}
+
+bool parking_occupy(parking_lot_t *lot, parking_spot_t spot) {
+  if (!parking_spot_valid(lot, spot))
+    return false;
+
+  parking_zone_t *zone = &lot->zones[spot.zone];
+  uint32_t word = spot.index / PARKING_WORD_BITS;
+  uint32_t mask = 1u << (spot.index % PARKING_WORD_BITS);
+  if (zone->spots[word] & mask)
+    return false;
+
+  zone->spots[word] |= mask;
+  parking_update_summary(zone, word);
+  zone->occupied++;
+  lot->occupied++;
+  return true;
+}
+
+bool parking_release(parking_lot_t *lot, parking_spot_t spot) {
+  if (!parking_spot_valid(lot, spot))
+    return false;
+
+  parking_zone_t *zone = &lot->zones[spot.zone];
+  uint32_t word = spot.index / PARKING_WORD_BITS;
+  uint32_t mask = 1u << (spot.index % PARKING_WORD_BITS);
+  if (!(zone->spots[word] & mask))
+    return false;
+
+  zone->spots[word] &= ~mask;
+  parking_update_summary(zone, word);
+  zone->occupied--;
+  lot->occupied--;
+  return true;
+}
+
+void parking_clear(parking_lot_t *lot) {
+  for (uint8_t z = 0; z < lot->zone_count; z++) {
+    memset(lot->zones[z].spots, 0, sizeof(lot->zones[z].spots));
+  }
+  parking_init(lot, lot->zones, lot->zone_count);
+}
+
+uint16_t parking_zone_count(const parking_zone_t *zone) {
+  uint16_t count = 0;
+
+  for (uint32_t w = 0; w < PARKING_ZONE_WORDS; w++) {
+    count += __builtin_popcount(zone->spots[w] & ~parking_pad_mask(zone, w));
+  }
+  return count;
+}
@@ -0,0 +1,75 @@
+#ifndef PARKING_H
+#define PARKING_H
+
+// Ocupação por zona (nível) com um bit por vaga.
+// A primeira vaga livre/ocupada é encontrada por varreduras de palavras inteiras (ctz),
+// e os totais da zona e do estacionamento são atualizados a cada evento: O(1) por vaga.
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define PARKING_WORD_BITS 32
+
+// Capacidade máxima de uma zona: os resumos 'full' e 'used' têm um bit por palavra
+#ifndef PARKING_ZONE_MAX_SPOTS
+#define PARKING_ZONE_MAX_SPOTS 1024
+#endif
+#define PARKING_ZONE_WORDS ((PARKING_ZONE_MAX_SPOTS + PARKING_WORD_BITS - 1) / PARKING_WORD_BITS)
+
+_Static_assert(PARKING_ZONE_WORDS <= PARKING_WORD_BITS, "PARKING_ZONE_MAX_SPOTS acima de 1024");
+
+// Seleciona a primeira zona com vaga livre (entrada) ou ocupada (saída)
+#define PARKING_ZONE_ANY 0xFF
+
+typedef struct {
+  const char *name;
+  uint16_t capacity;
+  uint16_t occupied;
+  uint32_t full; // Bit w: palavra w sem vagas livres
+  uint32_t used; // Bit w: palavra w com alguma vaga ocupada
+  uint32_t spots[PARKING_ZONE_WORDS]; // Bit = 1: vaga ocupada
+} parking_zone_t;
+
+typedef struct {
+  parking_zone_t *zones;
+  uint8_t zone_count;
+  uint16_t capacity;
+  uint16_t occupied;
+} parking_lot_t;
+
+// Identifica uma vaga: zona e posição dentro da zona
+typedef struct {
+  uint8_t zone;
+  uint16_t index;
+} parking_spot_t;
+
+// Prepara os resumos e os totais a partir dos bitmaps atuais das zonas. Falha (deixando o
+// estacionamento sem zonas) se alguma zona passar de PARKING_ZONE_MAX_SPOTS vagas ou se a
+// capacidade total não couber em 16 bits.
+bool parking_init(parking_lot_t *lot, parking_zone_t *zones, uint8_t zone_count);
+
+// Ocupa a primeira vaga livre da zona; falha se a zona (ou o estacionamento) estiver cheia
+bool parking_enter(parking_lot_t *lot, uint8_t zone, parking_spot_t *spot);
+
+// Libera a primeira vaga ocupada da zona; falha se a zona estiver vazia
+bool parking_leave(parking_lot_t *lot, uint8_t zone, parking_spot_t *spot);
+
+// Ocupa/libera uma vaga específica; falha se ela já estiver no estado pedido
+bool parking_occupy(parking_lot_t *lot, parking_spot_t spot);
+bool parking_release(parking_lot_t *lot, parking_spot_t spot);
+
+// Libera todas as vagas
+void parking_clear(parking_lot_t *lot);
+
+// Vagas ocupadas na zona, contadas diretamente no bitmap (popcount)
+uint16_t parking_zone_count(const parking_zone_t *zone);
+
+static inline uint16_t parking_zone_free(const parking_zone_t *zone) {
+  return zone->capacity - zone->occupied;
+}
+
+static inline uint16_t parking_lot_free(const parking_lot_t *lot) {
+  return lot->capacity - lot->occupied;
+}
+
+#endif
@@ -1,117 +1,331 @@
 #include "ssd1306.h"
-#include "font.h"
+#include <string.h>
 
-void ssd1306_init(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c) {
+static void ssd1306_stream_done(void *ctx);
+
+void ssd1306_init(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, hal_i2c_t i2c) {
   ssd->width = width;
   ssd->height = height;
   ssd->pages = height / 8U;
   ssd->address = address;
   ssd->i2c_port = i2c;
   ssd->bufsize = ssd->pages * ssd->width + 1;
-  ssd->ram_buffer = calloc(ssd->bufsize, sizeof(uint8_t));
+  if (ssd->bufsize > SSD1306_BUFSIZE)
+    hal_panic("Display maior que WIDTH x HEIGHT");
+
+  memset(ssd->ram_buffer, 0, ssd->bufsize);
   ssd->ram_buffer[0] = 0x40;
   ssd->port_buffer[0] = 0x80;
+  memset(ssd->shadow_buffer, 0, ssd->bufsize);
+  ssd->shadow_valid = false;
+
+  // Cada byte vira uma palavra de 16 bits do registrador DATA_CMD (com bit de STOP)
+  ssd->dma_busy = false;
+  ssd->dma_stream = hal_i2c_stream_claim(i2c);
+
+  // O conteúdo da RAM do display é desconhecido: o primeiro envio deve ser completo
+  ssd1306_mark_dirty(ssd, 0, 0, ssd->width - 1, ssd->height - 1);
 }
 
 void ssd1306_config(ssd1306_t *ssd) {
-  ssd1306_command(ssd, SET_DISP | 0x00);
-  ssd1306_command(ssd, SET_MEM_ADDR);
-  ssd1306_command(ssd, 0x01);
-  ssd1306_command(ssd, SET_DISP_START_LINE | 0x00);
-  ssd1306_command(ssd, SET_SEG_REMAP | 0x01);
-  ssd1306_command(ssd, SET_MUX_RATIO);
-  ssd1306_command(ssd, HEIGHT - 1);
-  ssd1306_command(ssd, SET_COM_OUT_DIR | 0x08);
-  ssd1306_command(ssd, SET_DISP_OFFSET);
-  ssd1306_command(ssd, 0x00);
-  ssd1306_command(ssd, SET_COM_PIN_CFG);
-  ssd1306_command(ssd, 0x12);
-  ssd1306_command(ssd, SET_DISP_CLK_DIV);
-  ssd1306_command(ssd, 0x80);
-  ssd1306_command(ssd, SET_PRECHARGE);
-  ssd1306_command(ssd, 0xF1);
-  ssd1306_command(ssd, SET_VCOM_DESEL);
-  ssd1306_command(ssd, 0x30);
-  ssd1306_command(ssd, SET_CONTRAST);
-  ssd1306_command(ssd, 0xFF);
-  ssd1306_command(ssd, SET_ENTIRE_ON);
-  ssd1306_command(ssd, SET_NORM_INV);
-  ssd1306_command(ssd, SET_CHARGE_PUMP);
-  ssd1306_command(ssd, 0x14);
-  ssd1306_command(ssd, SET_DISP | 0x01);
+  // Toda a sequência de inicialização vai em uma única transação I2C. O display continua
+  // desligado: ssd1306_display_on é chamada após o envio do primeiro quadro.
+  static const uint8_t config_cmds[] = {
+    SET_DISP | 0x00,
+    SET_MEM_ADDR, 0x01,
+    SET_DISP_START_LINE | 0x00,
+    SET_SEG_REMAP | 0x01,
+    SET_MUX_RATIO, HEIGHT - 1,
+    SET_COM_OUT_DIR | 0x08,
+    SET_DISP_OFFSET, 0x00,
+    SET_COM_PIN_CFG, 0x12,
+    SET_DISP_CLK_DIV, 0x80,
+    SET_PRECHARGE, 0xF1,
+    SET_VCOM_DESEL, 0x30,
+    SET_CONTRAST, 0xFF,
+    SET_ENTIRE_ON,
+    SET_NORM_INV,
+    SET_CHARGE_PUMP, 0x14,
+  };
+  ssd1306_command_batch(ssd, config_cmds, sizeof(config_cmds));
+}
+
+void ssd1306_display_on(ssd1306_t *ssd, bool on) {
+  ssd1306_command(ssd, SET_DISP | (on ? 0x01 : 0x00));
 }
 
 void ssd1306_command(ssd1306_t *ssd, uint8_t command) {
+  ssd1306_wait(ssd);
   ssd->port_buffer[1] = command;
-  i2c_write_blocking(
-    ssd->i2c_port,
-    ssd->address,
-    ssd->port_buffer,
-    2,
-    false
-  );
+  hal_i2c_write(ssd->i2c_port, ssd->address, ssd->port_buffer, 2);
+}
+
+// Envia uma sequência de comandos em uma única transação: byte de controle 0x00 seguido dos comandos
+void ssd1306_command_batch(ssd1306_t *ssd, const uint8_t *cmds, size_t count) {
+  uint8_t buffer[SSD1306_BATCH_MAX + 1];
+  buffer[0] = 0x00;
+
+  ssd1306_wait(ssd);
+  while (count > 0) {
+    size_t chunk = count < SSD1306_BATCH_MAX ? count : SSD1306_BATCH_MAX;
+    memcpy(&buffer[1], cmds, chunk);
+    hal_i2c_write(ssd->i2c_port, ssd->address, buffer, chunk + 1);
+    cmds += chunk;
+    count -= chunk;
+  }
+}
+
+// Marca como alterada a região (x0, y0)-(x1, y1), expandindo a janela do próximo envio
+void ssd1306_mark_dirty(ssd1306_t *ssd, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1) {
+  if (x0 >= ssd->width || y0 >= ssd->height)
+    return;
+  if (x1 >= ssd->width)
+    x1 = ssd->width - 1;
+  if (y1 >= ssd->height)
+    y1 = ssd->height - 1;
+
+  uint8_t page0 = y0 >> 3;
+  uint8_t page1 = y1 >> 3;
+
+  if (!ssd->dirty) {
+    ssd->dirty = true;
+    ssd->dirty_x0 = x0;
+    ssd->dirty_x1 = x1;
+    ssd->dirty_page0 = page0;
+    ssd->dirty_page1 = page1;
+    return;
+  }
+
+  if (x0 < ssd->dirty_x0) ssd->dirty_x0 = x0;
+  if (x1 > ssd->dirty_x1) ssd->dirty_x1 = x1;
+  if (page0 < ssd->dirty_page0) ssd->dirty_page0 = page0;
+  if (page1 > ssd->dirty_page1) ssd->dirty_page1 = page1;
+}
+
+// Compara a região alterada com o último quadro enviado (shadow_buffer) e gera as janelas
+// mínimas de colunas com bytes diferentes. Colunas vizinhas separadas por poucos bytes iguais
+// são agrupadas, pois cada janela extra custa uma nova sequência de endereçamento.
+static uint8_t ssd1306_diff_windows(ssd1306_t *ssd, ssd1306_window_t windows[SSD1306_MAX_WINDOWS]) {
+  ssd1306_window_t dirty = { ssd->dirty_x0, ssd->dirty_x1, ssd->dirty_page0, ssd->dirty_page1 };
+  ssd->dirty = false;
+
+  // Sem um quadro anterior conhecido, toda a região alterada precisa ser enviada
+  if (!ssd->shadow_valid) {
+    windows[0] = dirty;
+    return 1;
+  }
+
+  uint8_t count = 0;
+  uint8_t gap = 0;
+  for (uint8_t x = dirty.x0; x <= dirty.x1; ++x) {
+    const uint8_t *column = &ssd->ram_buffer[1 + x * ssd->pages];
+    const uint8_t *shadow = &ssd->shadow_buffer[1 + x * ssd->pages];
+
+    // Localiza a primeira e a última página alteradas desta coluna
+    uint8_t page0 = 0xFF, page1 = 0;
+    for (uint8_t p = dirty.page0; p <= dirty.page1; ++p) {
+      if (column[p] != shadow[p]) {
+        if (page0 == 0xFF) page0 = p;
+        page1 = p;
+      }
+    }
+
+    if (page0 == 0xFF) {
+      ++gap;
+      continue;
+    }
+
+    ssd1306_window_t *last = count ? &windows[count - 1] : NULL;
+    bool merge = last && (count == SSD1306_MAX_WINDOWS ||
+                          gap * (last->page1 - last->page0 + 1) <= SSD1306_WINDOW_OVERHEAD);
+    if (merge) {
+      last->x1 = x;
+      if (page0 < last->page0) last->page0 = page0;
+      if (page1 > last->page1) last->page1 = page1;
+    } else {
+      windows[count++] = (ssd1306_window_t){ x, x, page0, page1 };
+    }
+    gap = 0;
+  }
+
+  return count;
 }
 
+// Monta em 'out' a transação completa de uma janela e registra o conteúdo no shadow_buffer.
+// Os comandos de endereçamento usam bytes de controle 0x80 (Co = 1, um comando por vez),
+// seguidos de 0x40 e dos dados: endereçamento e conteúdo seguem em uma única transação.
+static size_t ssd1306_build_window(ssd1306_t *ssd, const ssd1306_window_t *window, uint8_t *out) {
+  const uint8_t cmds[SSD1306_WINDOW_CMDS] = {
+    SET_COL_ADDR, window->x0, window->x1,
+    SET_PAGE_ADDR, window->page0, window->page1
+  };
+
+  size_t len = 0;
+  for (uint8_t i = 0; i < SSD1306_WINDOW_CMDS; ++i) {
+    out[len++] = ssd->port_buffer[0];
+    out[len++] = cmds[i];
+  }
+  out[len++] = 0x40;
+
+  // Com endereçamento vertical, cada coluna ocupa 'pages' bytes consecutivos no buffer
+  uint8_t pages = window->page1 - window->page0 + 1;
+  for (uint8_t x = window->x0; x <= window->x1; ++x) {
+    size_t offset = 1 + x * ssd->pages + window->page0;
+    memcpy(&out[len], &ssd->ram_buffer[offset], pages);
+    memcpy(&ssd->shadow_buffer[offset], &ssd->ram_buffer[offset], pages);
+    len += pages;
+  }
+
+  return len;
+}
+
+// Envia ao display apenas os bytes que mudaram desde o último envio (uma transação por janela)
 void ssd1306_send_data(ssd1306_t *ssd) {
-  ssd1306_command(ssd, SET_COL_ADDR);
-  ssd1306_command(ssd, 0);
-  ssd1306_command(ssd, ssd->width - 1);
-  ssd1306_command(ssd, SET_PAGE_ADDR);
-  ssd1306_command(ssd, 0);
-  ssd1306_command(ssd, ssd->pages - 1);
-  i2c_write_blocking(
-    ssd->i2c_port,
-    ssd->address,
-    ssd->ram_buffer,
-    ssd->bufsize,
-    false
-  );
+  if (!ssd->dirty)
+    return;
+
+  ssd1306_window_t windows[SSD1306_MAX_WINDOWS];
+  uint8_t count = ssd1306_diff_windows(ssd, windows);
+
+  ssd1306_wait(ssd);
+  for (uint8_t w = 0; w < count; ++w) {
+    size_t len = ssd1306_build_window(ssd, &windows[w], ssd->tx_buffer);
+    hal_i2c_write(ssd->i2c_port, ssd->address, ssd->tx_buffer, len);
+  }
+
+  ssd->shadow_valid = true;
+}
+
+// Inicia o envio das alterações via DMA e retorna imediatamente.
+// Retorna false se nenhum byte mudou ou se já existe uma transferência em andamento;
+// caso contrário 'callback' é chamado (em contexto de interrupção) ao término do DMA.
+bool ssd1306_send_data_async(ssd1306_t *ssd, ssd1306_callback_t callback, void *ctx) {
+  if (!ssd->dirty || ssd->dma_busy)
+    return false;
+
+  ssd1306_window_t windows[SSD1306_MAX_WINDOWS];
+  uint8_t count = ssd1306_diff_windows(ssd, windows);
+  if (count == 0)
+    return false;
+
+  // Aguarda a FIFO esvaziar de uma transferência anterior antes de reprogramar o endereço
+  ssd1306_wait(ssd);
+
+  // Cada janela é uma transação terminada em STOP
+  uint16_t *word = ssd->dma_buffer;
+  for (uint8_t w = 0; w < count; ++w) {
+    size_t len = ssd1306_build_window(ssd, &windows[w], ssd->tx_buffer);
+    for (size_t i = 0; i < len; ++i)
+      *word++ = ssd->tx_buffer[i];
+    word[-1] |= HAL_I2C_STOP;
+  }
+  ssd->shadow_valid = true;
+
+  ssd->callback = callback;
+  ssd->callback_ctx = ctx;
+  ssd->dma_busy = true;
+
+  hal_i2c_stream_start(ssd->dma_stream, ssd->address, ssd->dma_buffer, word - ssd->dma_buffer,
+                       ssd1306_stream_done, ssd);
+  return true;
+}
+
+// Indica se ainda há uma transferência assíncrona sendo alimentada pelo DMA
+bool ssd1306_busy(ssd1306_t *ssd) {
+  return ssd->dma_busy;
+}
+
+// Bloqueia até o DMA terminar e o controlador I2C concluir o último byte (STOP)
+void ssd1306_wait(ssd1306_t *ssd) {
+  // Bloqueia até a interrupção de fim do DMA; só a FIFO restante é aguardada em espera ativa
+  while (ssd->dma_busy)
+    hal_i2c_stream_wait(ssd->dma_stream);
+
+  hal_i2c_wait_idle(ssd->i2c_port);
+}
+
+// Término do fluxo I2C (contexto de interrupção): libera o display e notifica o chamador
+static void ssd1306_stream_done(void *ctx) {
+  ssd1306_t *ssd = ctx;
+  ssd->dma_busy = false;
+
+  if (ssd->callback)
+    ssd->callback(ssd, ssd->callback_ctx);
 }
 
 void ssd1306_pixel(ssd1306_t *ssd, uint8_t x, uint8_t y, bool value) {
+  if (x >= ssd->width || y >= ssd->height)
+    return;
   uint16_t index = (y >> 3) + (x << 3) + 1;
   uint8_t pixel = (y & 0b111);
   if (value)
     ssd->ram_buffer[index] |= (1 << pixel);
   else
     ssd->ram_buffer[index] &= ~(1 << pixel);
+  ssd1306_mark_dirty(ssd, x, y, x, y);
 }
 
-/*
-void ssd1306_fill(ssd1306_t *ssd, bool value) {
-  uint8_t byte = value ? 0xFF : 0x00;
-  for (uint8_t i = 1; i < ssd->bufsize; ++i)
-    ssd->ram_buffer[i] = byte;
-}*/
+// Preenche (ou apaga) o retângulo de colunas x0..x1 e linhas y0..y1 byte a byte.
+// Cada página recebe uma máscara pré-calculada; apenas a primeira e a última são parciais.
+static void ssd1306_blit_span(ssd1306_t *ssd, uint8_t x0, uint8_t x1, uint8_t y0, uint8_t y1, bool value) {
+  if (x0 > x1 || y0 > y1 || x0 >= ssd->width || y0 >= ssd->height)
+    return;
+  if (x1 >= ssd->width)
+    x1 = ssd->width - 1;
+  if (y1 >= ssd->height)
+    y1 = ssd->height - 1;
 
-void ssd1306_fill(ssd1306_t *ssd, bool value) {
-    // Itera por todas as posições do display
-    for (uint8_t y = 0; y < ssd->height; ++y) {
-        for (uint8_t x = 0; x < ssd->width; ++x) {
-            ssd1306_pixel(ssd, x, y, value);
-        }
+  uint8_t page0 = y0 >> 3;
+  uint8_t page1 = y1 >> 3;
+  uint8_t masks[8];
+  for (uint8_t p = page0; p <= page1; ++p)
+    masks[p - page0] = 0xFF;
+  masks[0] &= (uint8_t)(0xFF << (y0 & 0b111));
+  masks[page1 - page0] &= (uint8_t)(0xFF >> (7 - (y1 & 0b111)));
+
+  uint8_t pages = page1 - page0 + 1;
+  uint8_t *column = &ssd->ram_buffer[1 + x0 * ssd->pages + page0];
+  for (uint8_t x = x0; x <= x1; ++x, column += ssd->pages) {
+    if (value) {
+      for (uint8_t p = 0; p < pages; ++p)
+        column[p] |= masks[p];
+    } else {
+      for (uint8_t p = 0; p < pages; ++p)
+        column[p] &= ~masks[p];
     }
+  }
+
+  ssd1306_mark_dirty(ssd, x0, y0, x1, y1);
 }
 
+void ssd1306_fill(ssd1306_t *ssd, bool value) {
+  memset(&ssd->ram_buffer[1], value ? 0xFF : 0x00, ssd->bufsize - 1);
+  ssd1306_mark_dirty(ssd, 0, 0, ssd->width - 1, ssd->height - 1);
+}
 
+// Substitui o quadro por uma imagem pronta no formato do buffer (ex.: lib/ui_screens.h)
+void ssd1306_load(ssd1306_t *ssd, const uint8_t *image) {
+  memcpy(&ssd->ram_buffer[1], image, ssd->bufsize - 1);
+  ssd1306_mark_dirty(ssd, 0, 0, ssd->width - 1, ssd->height - 1);
+}
 
 void ssd1306_rect(ssd1306_t *ssd, uint8_t top, uint8_t left, uint8_t width, uint8_t height, bool value, bool fill) {
-  for (uint8_t x = left; x < left + width; ++x) {
-    ssd1306_pixel(ssd, x, top, value);
-    ssd1306_pixel(ssd, x, top + height - 1, value);
-  }
-  for (uint8_t y = top; y < top + height; ++y) {
-    ssd1306_pixel(ssd, left, y, value);
-    ssd1306_pixel(ssd, left + width - 1, y, value);
-  }
+  if (width == 0 || height == 0)
+    return;
+
+  uint8_t right = left + width - 1;
+  uint8_t bottom = top + height - 1;
 
+  // Borda e interior possuem o mesmo valor: o retângulo cheio é um único bloco
   if (fill) {
-    for (uint8_t x = left + 1; x < left + width - 1; ++x) {
-      for (uint8_t y = top + 1; y < top + height - 1; ++y) {
-        ssd1306_pixel(ssd, x, y, value);
-      }
-    }
+    ssd1306_blit_span(ssd, left, right, top, bottom, value);
+    return;
   }
+
+  ssd1306_hline(ssd, left, right, top, value);
+  ssd1306_hline(ssd, left, right, bottom, value);
+  ssd1306_vline(ssd, left, top, bottom, value);
+  ssd1306_vline(ssd, right, top, bottom, value);
 }
 
 void ssd1306_line(ssd1306_t *ssd, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, bool value) {
@@ -143,14 +357,14 @@ void ssd1306_line(ssd1306_t *ssd, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1
 }
 
 
+// Linha horizontal: a mesma máscara de um bit aplicada a cada coluna do intervalo
 void ssd1306_hline(ssd1306_t *ssd, uint8_t x0, uint8_t x1, uint8_t y, bool value) {
-  for (uint8_t x = x0; x <= x1; ++x)
-    ssd1306_pixel(ssd, x, y, value);
+  ssd1306_blit_span(ssd, x0, x1, y, y, value);
 }
 
+// Linha vertical: bytes inteiros da coluna, com máscaras apenas nas páginas das pontas
 void ssd1306_vline(ssd1306_t *ssd, uint8_t x, uint8_t y0, uint8_t y1, bool value) {
-  for (uint8_t y = y0; y <= y1; ++y)
-    ssd1306_pixel(ssd, x, y, value);
+  ssd1306_blit_span(ssd, x, x, y0, y1, value);
 }
 
 // Função para desenhar um caractere
@@ -169,15 +383,33 @@ void ssd1306_draw_char(ssd1306_t *ssd, char c, uint8_t x, uint8_t y)
     index = 0; // Índice 0 corresponde ao caractere "nada" (espaço)
   }
 
-  // Desenha o caractere na tela
-  for (uint8_t i = 0; i < 8; ++i)
+  if (x >= ssd->width || y >= ssd->height)
+    return;
+
+  // A fonte já está em bytes de coluna (bit 0 = linha superior), o mesmo formato da RAM do display
+  uint8_t page = y >> 3;
+  uint8_t shift = y & 0b111;
+  uint8_t columns = (ssd->width - x < 8) ? ssd->width - x : 8;
+  bool has_next_page = shift && page + 1 < ssd->pages;
+  uint8_t *column = &ssd->ram_buffer[1 + x * ssd->pages + page];
+
+  for (uint8_t i = 0; i < columns; ++i, column += ssd->pages)
   {
-    uint8_t line = font[index + i]; // Acessa a linha correspondente do caractere na fonte
-    for (uint8_t j = 0; j < 8; ++j)
+    uint8_t line = font_8x8.columns[index + i]; // Acessa a coluna correspondente do caractere na fonte
+    if (shift == 0)
+    {
+      column[0] = line; // y alinhado à página: cópia direta do byte
+    }
+    else
     {
-      ssd1306_pixel(ssd, x + i, y + j, line & (1 << j)); // Desenha cada pixel do caractere
+      // y desalinhado: a coluna se divide entre duas páginas adjacentes
+      column[0] = (column[0] & (uint8_t)~(0xFF << shift)) | (uint8_t)(line << shift);
+      if (has_next_page)
+        column[1] = (column[1] & (uint8_t)~(0xFF >> (8 - shift))) | (uint8_t)(line >> (8 - shift));
     }
   }
+
+  ssd1306_mark_dirty(ssd, x, y, x + columns - 1, y + 7);
 }
 
 // Função para desenhar uma string
@@ -198,3 +430,64 @@ void ssd1306_draw_string(ssd1306_t *ssd, const char *str, uint8_t x, uint8_t y)
     }
   }
 }
+
+// Expansão de 4 linhas de uma coluna da fonte: cada bit vira 2 (ou 3) bits iguais
+static const uint8_t expand2[16] = {
+  0x00, 0x03, 0x0C, 0x0F, 0x30, 0x33, 0x3C, 0x3F, 0xC0, 0xC3, 0xCC, 0xCF, 0xF0, 0xF3, 0xFC, 0xFF
+};
+static const uint16_t expand3[16] = {
+  0x000, 0x007, 0x038, 0x03F, 0x1C0, 0x1C7, 0x1F8, 0x1FF, 0xE00, 0xE07, 0xE38, 0xE3F, 0xFC0, 0xFC7, 0xFF8, 0xFFF
+};
+
+// Coluna da fonte ampliada verticalmente na escala indicada (1 a 3)
+static uint32_t ssd1306_scale_column(uint8_t line, uint8_t scale) {
+  switch (scale) {
+    case 2:
+      return expand2[line & 0x0F] | (uint32_t)expand2[line >> 4] << 8;
+    case 3:
+      return expand3[line & 0x0F] | (uint32_t)expand3[line >> 4] << 12;
+    default:
+      return line;
+  }
+}
+
+// Substitui as linhas y..y+height-1 da coluna x por 'bits' (bit 0 = linha y), página a página
+static void ssd1306_put_column(ssd1306_t *ssd, uint8_t x, uint8_t y, uint32_t bits, uint8_t height) {
+  uint8_t *column = &ssd->ram_buffer[1 + x * ssd->pages];
+  uint8_t shift = y & 0b111;
+  uint64_t mask = (((uint64_t)1 << height) - 1) << shift;
+  uint64_t value = ((uint64_t)bits << shift) & mask;
+
+  for (uint8_t page = y >> 3; page < ssd->pages && mask; ++page, mask >>= 8, value >>= 8)
+    column[page] = (column[page] & (uint8_t)~mask) | (uint8_t)value;
+}
+
+// Desenha um glifo de 'font' ampliado 'scale' vezes (1 a SSD1306_FONT_MAX_SCALE), incluindo as
+// colunas de espaçamento. Retorna o avanço horizontal em pixels.
+uint8_t ssd1306_draw_glyph(ssd1306_t *ssd, const ssd1306_font_t *font, char c, uint8_t x, uint8_t y, uint8_t scale) {
+  const uint8_t *columns;
+  uint8_t width = font_glyph(font, c, &columns);
+  uint8_t height = font->height * scale;
+  uint8_t advance = (width + font->spacing) * scale;
+
+  if (scale == 0 || scale > SSD1306_FONT_MAX_SCALE || x >= ssd->width || y >= ssd->height)
+    return advance;
+
+  uint8_t end = (ssd->width - x < advance) ? ssd->width : x + advance;
+  for (uint8_t col = x; col < end; ++col) {
+    uint8_t i = (col - x) / scale;
+    uint32_t bits = i < width ? ssd1306_scale_column(columns[i], scale) : 0;
+    ssd1306_put_column(ssd, col, y, bits, height);
+  }
+
+  ssd1306_mark_dirty(ssd, x, y, end - 1, y + height - 1);
+  return advance;
+}
+
+// Desenha um texto em uma linha, avançando pela largura de cada glifo (sem quebra de linha).
+// Retorna a coluna seguinte ao último glifo.
+uint8_t ssd1306_draw_text(ssd1306_t *ssd, const ssd1306_font_t *font, const char *str, uint8_t x, uint8_t y, uint8_t scale) {
+  while (*str && x < ssd->width)
+    x += ssd1306_draw_glyph(ssd, font, *str++, x, y, scale);
+  return x;
+}
@@ -1,10 +1,31 @@
+#ifndef SSD1306_H
+#define SSD1306_H
+
 #include <stdlib.h>
-#include "pico/stdlib.h"
-#include "hardware/i2c.h"
+#include "hal.h"
+#include "fonts.h"
 
 #define WIDTH 128
 #define HEIGHT 64
 
+// Número de bytes de comando que definem a janela de colunas/páginas de um envio
+#define SSD1306_WINDOW_CMDS 6
+
+// Máximo de janelas por envio e custo aproximado (em bytes no barramento) de abrir uma nova janela
+#define SSD1306_MAX_WINDOWS 16
+#define SSD1306_WINDOW_OVERHEAD 14
+
+// Maior escala de ssd1306_draw_glyph (glifos de até 8 * 3 = 24 linhas)
+#define SSD1306_FONT_MAX_SCALE 3
+
+// Máximo de comandos por transação em ssd1306_command_batch
+#define SSD1306_BATCH_MAX 32
+
+// Tamanho dos buffers do display (byte de controle + um byte por coluna de cada página).
+// Os buffers ficam dentro de ssd1306_t: nenhum é alocado em tempo de execução.
+#define SSD1306_BUFSIZE (WIDTH * HEIGHT / 8 + 1)
+#define SSD1306_DMA_WORDS (SSD1306_BUFSIZE + SSD1306_MAX_WINDOWS * (SSD1306_WINDOW_CMDS * 2 + 1))
+
 typedef enum {
   SET_CONTRAST = 0x81,
   SET_ENTIRE_ON = 0xA4,
@@ -25,25 +46,57 @@ typedef enum {
   SET_CHARGE_PUMP = 0x8D
 } ssd1306_command_t;
 
+typedef struct ssd1306 ssd1306_t;
+
+// Janela retangular de colunas x0..x1 e páginas page0..page1
 typedef struct {
+  uint8_t x0, x1, page0, page1;
+} ssd1306_window_t;
+
+// Chamado em contexto de interrupção quando uma transferência assíncrona termina
+typedef void (*ssd1306_callback_t)(ssd1306_t *ssd, void *ctx);
+
+struct ssd1306 {
   uint8_t width, height, pages, address;
-  i2c_inst_t *i2c_port;
+  hal_i2c_t i2c_port;
   bool external_vcc;
-  uint8_t *ram_buffer;
+  uint8_t ram_buffer[SSD1306_BUFSIZE];
   size_t bufsize;
   uint8_t port_buffer[2];
-} ssd1306_t;
+  uint8_t tx_buffer[SSD1306_WINDOW_CMDS * 2 + SSD1306_BUFSIZE]; // Área de montagem da janela enviada ao display
+  bool dirty;                           // Indica se há região alterada desde o último envio
+  uint8_t dirty_x0, dirty_x1;           // Colunas inicial e final da região alterada
+  uint8_t dirty_page0, dirty_page1;     // Páginas inicial e final da região alterada
+  uint8_t shadow_buffer[SSD1306_BUFSIZE]; // Cópia do último quadro efetivamente enviado ao display
+  bool shadow_valid;                    // Falso até o primeiro envio (conteúdo do display desconhecido)
+  uint16_t dma_buffer[SSD1306_DMA_WORDS]; // Palavras (byte | HAL_I2C_STOP) alimentadas pelo DMA na FIFO TX do I2C
+  int dma_stream;
+  volatile bool dma_busy;
+  ssd1306_callback_t callback;
+  void *callback_ctx;
+};
 
-void ssd1306_init(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c);
+void ssd1306_init(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, hal_i2c_t i2c);
 void ssd1306_config(ssd1306_t *ssd);
+void ssd1306_display_on(ssd1306_t *ssd, bool on);
 void ssd1306_command(ssd1306_t *ssd, uint8_t command);
+void ssd1306_command_batch(ssd1306_t *ssd, const uint8_t *cmds, size_t count);
 void ssd1306_send_data(ssd1306_t *ssd);
+bool ssd1306_send_data_async(ssd1306_t *ssd, ssd1306_callback_t callback, void *ctx);
+bool ssd1306_busy(ssd1306_t *ssd);
+void ssd1306_wait(ssd1306_t *ssd);
+void ssd1306_mark_dirty(ssd1306_t *ssd, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1);
 
 void ssd1306_pixel(ssd1306_t *ssd, uint8_t x, uint8_t y, bool value);
 void ssd1306_fill(ssd1306_t *ssd, bool value);
+void ssd1306_load(ssd1306_t *ssd, const uint8_t *image);
 void ssd1306_rect(ssd1306_t *ssd, uint8_t top, uint8_t left, uint8_t width, uint8_t height, bool value, bool fill);
 void ssd1306_line(ssd1306_t *ssd, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, bool value);
 void ssd1306_hline(ssd1306_t *ssd, uint8_t x0, uint8_t x1, uint8_t y, bool value);
 void ssd1306_vline(ssd1306_t *ssd, uint8_t x, uint8_t y0, uint8_t y1, bool value);
 void ssd1306_draw_char(ssd1306_t *ssd, char c, uint8_t x, uint8_t y);
 void ssd1306_draw_string(ssd1306_t *ssd, const char *str, uint8_t x, uint8_t y);
+uint8_t ssd1306_draw_glyph(ssd1306_t *ssd, const ssd1306_font_t *font, char c, uint8_t x, uint8_t y, uint8_t scale);
+uint8_t ssd1306_draw_text(ssd1306_t *ssd, const ssd1306_font_t *font, const char *str, uint8_t x, uint8_t y, uint8_t scale);
+
+#endif
@@ -0,0 +1,117 @@
+#include "telemetry.h"
+#include "hal.h"
+#include <string.h>
+
+#define TELEMETRY_RING_MASK (TELEMETRY_RING_SIZE - 1)
+
+// Anel de um único produtor e um único consumidor: 'head' só é escrito pelo produtor e 'tail'
+// só pela tarefa de telemetria, então nenhum dos dois precisa de trava
+typedef struct {
+  telemetry_record_t records[TELEMETRY_RING_SIZE];
+  volatile uint32_t head;
+  volatile uint32_t tail;
+  volatile uint32_t dropped;
+} telemetry_ring_t;
+
+static telemetry_ring_t rings[TELEMETRY_SRC_COUNT];
+static volatile bool enabled = false;
+static uint8_t frame[TELEMETRY_FRAME_OVERHEAD + TELEMETRY_FRAME_MAX * sizeof(telemetry_record_t)];
+static uint8_t frame_seq = 0;
+
+void telemetry_set_enabled(bool on) {
+  enabled = on;
+}
+
+bool telemetry_enabled(void) {
+  return enabled;
+}
+
+void telemetry_emit(telemetry_source_t source, uint8_t type, uint8_t id, uint16_t arg, uint32_t value0,
+                    uint32_t value1) {
+  if (!enabled)
+    return;
+
+  telemetry_ring_t *ring = &rings[source];
+  uint32_t head = ring->head;
+  if (head - ring->tail == TELEMETRY_RING_SIZE) {
+    ring->dropped++;
+    return;
+  }
+
+  telemetry_record_t *record = &ring->records[head & TELEMETRY_RING_MASK];
+  record->type = type;
+  record->id = id;
+  record->arg = arg;
+  record->time_us = hal_time_us32();
+  record->value0 = value0;
+  record->value1 = value1;
+
+  // O registro precisa estar completo na memória antes de o consumidor ver o novo 'head'
+  __sync_synchronize();
+  ring->head = head + 1;
+}
+
+// Retira um registro do anel; falso se estiver vazio
+static bool telemetry_pop(telemetry_ring_t *ring, telemetry_record_t *record) {
+  uint32_t tail = ring->tail;
+  if (tail == ring->head)
+    return false;
+
+  __sync_synchronize();
+  memcpy(record, &ring->records[tail & TELEMETRY_RING_MASK], sizeof(*record));
+  __sync_synchronize();
+  ring->tail = tail + 1;
+  return true;
+}
+
+// Fecha o quadro com 'count' registros já copiados e o envia
+static void telemetry_send(uint8_t count) {
+  size_t len = 4 + count * sizeof(telemetry_record_t);
+
+  frame[0] = TELEMETRY_SYNC0;
+  frame[1] = TELEMETRY_SYNC1;
+  frame[2] = count;
+  frame[3] = frame_seq++;
+
+  uint16_t crc = telemetry_crc16(&frame[2], len - 2);
+  frame[len] = crc & 0xFF;
+  frame[len + 1] = crc >> 8;
+  hal_telemetry_write(frame, len + 2);
+}
+
+uint32_t telemetry_drain(void) {
+  telemetry_record_t *records = (telemetry_record_t *)&frame[4];
+  uint32_t sent = 0;
+  uint8_t count = 0;
+  bool pending = true;
+
+  // Percorre os anéis alternadamente, para que uma origem muito ativa não atrase as demais
+  while (pending) {
+    pending = false;
+    for (uint8_t s = 0; s < TELEMETRY_SRC_COUNT; s++) {
+      if (!telemetry_pop(&rings[s], &records[count]))
+        continue;
+
+      pending = true;
+      if (++count == TELEMETRY_FRAME_MAX) {
+        telemetry_send(count);
+        sent += count;
+        count = 0;
+      }
+    }
+  }
+
+  if (count > 0) {
+    telemetry_send(count);
+    sent += count;
+  }
+  return sent;
+}
+
+uint32_t telemetry_dropped(void) {
+  uint32_t dropped = 0;
+
+  for (uint8_t s = 0; s < TELEMETRY_SRC_COUNT; s++)
+    dropped += rings[s].dropped;
+  return dropped;
+}
@@ -0,0 +1,78 @@
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+// Telemetria binária: registros de tamanho fixo enviados em quadros pelo console USB
+// (hal_telemetry_write). Cada contexto produtor escreve no seu próprio anel (um produtor e um
+// consumidor, sem trava nem seção crítica); a tarefa de telemetria esvazia os anéis em lotes.
+//
+// Quadro: 0xA5 0x5A | n (1..TELEMETRY_FRAME_MAX) | seq | n registros | CRC-16 (LE)
+// O CRC (CCITT, 0x1021, inicial 0xFFFF) cobre de 'n' até o último registro. Um decodificador
+// procura o par de sincronismo e valida o CRC, então texto do printf no mesmo canal é ignorado.
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#define TELEMETRY_SYNC0 0xA5
+#define TELEMETRY_SYNC1 0x5A
+#define TELEMETRY_FRAME_MAX 16
+#define TELEMETRY_FRAME_OVERHEAD 6
+#define TELEMETRY_RING_SIZE 32 // Potência de 2
+
+typedef enum {
+  TELEMETRY_GATE_EVENT = 1, // id = portão, arg = borda (0 se injetado) | (display ocupado << 8)
+  TELEMETRY_PARKING,        // id = tipo (EVENT_LOG_*), arg = vaga, value0 = zona, value1 = vagas livres
+  TELEMETRY_OCCUPANCY,      // id = zona, arg = ocupadas, value0 = capacidade
+  TELEMETRY_LATENCY,        // id = etapa (TRACE_*), value0 = duração (us)
+  TELEMETRY_TASK_STATS,     // id = tarefa, value0 = tempo de CPU (us, 32 bits inferiores), value1 = folga de pilha (palavras)
+  TELEMETRY_STATUS,         // value0 = registros descartados, value1 = eventos de portão perdidos
+} telemetry_type_t;
+
+// Contextos produtores: cada um deve escrever sempre a partir de um único contexto por vez
+typedef enum {
+  TELEMETRY_SRC_GPIO,    // Interrupção dos botões
+  TELEMETRY_SRC_PARKING, // Tarefas dos portões, sob o mutex das zonas
+  TELEMETRY_SRC_DISPLAY, // Interrupção de fim do envio do display
+  TELEMETRY_SRC_SYSTEM,  // Tarefa de telemetria (amostras periódicas)
+  TELEMETRY_SRC_CONSOLE, // Tarefa do console (eventos injetados)
+  TELEMETRY_SRC_COUNT
+} telemetry_source_t;
+
+typedef struct __attribute__((packed)) {
+  uint8_t type;
+  uint8_t id;
+  uint16_t arg;
+  uint32_t time_us; // hal_time_us32 no momento do registro
+  uint32_t value0;
+  uint32_t value1;
+} telemetry_record_t;
+
+_Static_assert(sizeof(telemetry_record_t) == 16, "registro de telemetria deve ter 16 bytes");
+
+// Liga/desliga o envio. Desligada, telemetry_emit retorna sem escrever nos anéis.
+void telemetry_set_enabled(bool enabled);
+bool telemetry_enabled(void);
+
+// Registra um evento no anel da origem; descarta (e contabiliza) se o anel estiver cheio
+void telemetry_emit(telemetry_source_t source, uint8_t type, uint8_t id, uint16_t arg, uint32_t value0,
+                    uint32_t value1);
+
+// Esvazia os anéis em quadros de até TELEMETRY_FRAME_MAX registros. Retorna os registros enviados.
+uint32_t telemetry_drain(void);
+
+// Registros descartados por anéis cheios desde o boot
+uint32_t telemetry_dropped(void);
+
+// CRC-16/CCITT bit a bit (também usado pelo decodificador)
+static inline uint16_t telemetry_crc16(const uint8_t *data, size_t len) {
+  uint16_t crc = 0xFFFF;
+
+  for (size_t i = 0; i < len; ++i) {
+    crc ^= (uint16_t)data[i] << 8;
+    for (uint8_t bit = 0; bit < 8; ++bit)
+      crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+  }
+  return crc;
+}
+
+#endif
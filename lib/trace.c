@@ -0,0 +1,94 @@
+#include "trace.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include <stdio.h>
+#include <string.h>
+
+static trace_histogram_t histograms[TRACE_STAGE_COUNT];
+
+static const char *const stage_names[TRACE_STAGE_COUNT] = {
+  [TRACE_GATE_QUEUE] = "irq->portao",
+  [TRACE_GATE_QUEUE_BUSY] = "irq->portao*",
+  [TRACE_PARKING_MUTEX] = "mutex zonas",
+  [TRACE_DISPLAY_QUEUE] = "fila display",
+  [TRACE_RENDER] = "desenho",
+  [TRACE_FLUSH] = "envio i2c",
+  [TRACE_TOTAL] = "irq->display",
+};
+
+// Faixa do histograma: 0 para 0 us, k para [2^(k-1), 2^k) us
+static uint8_t trace_bucket(uint32_t us) {
+  uint8_t bucket = us ? 32 - __builtin_clz(us) : 0;
+  return bucket < TRACE_BUCKETS ? bucket : TRACE_BUCKETS - 1;
+}
+
+void trace_record(trace_stage_t stage, uint32_t start_us, uint32_t end_us) {
+  uint32_t us = end_us - start_us;
+  trace_histogram_t *h = &histograms[stage];
+
+  // A variante FROM_ISR também é válida em tarefas: apenas mascara as interrupções
+  UBaseType_t saved = taskENTER_CRITICAL_FROM_ISR();
+  if (h->count == 0 || us < h->min_us)
+    h->min_us = us;
+  if (us > h->max_us)
+    h->max_us = us;
+  h->count++;
+  h->sum_us += us;
+  h->buckets[trace_bucket(us)]++;
+  taskEXIT_CRITICAL_FROM_ISR(saved);
+}
+
+// Limite superior da faixa que contém o percentil 'pct' (aproximação pelo histograma)
+static uint32_t trace_percentile(const trace_histogram_t *h, uint32_t pct) {
+  uint32_t target = (h->count * pct + 99) / 100;
+  uint32_t seen = 0;
+
+  for (uint8_t b = 0; b < TRACE_BUCKETS; b++) {
+    seen += h->buckets[b];
+    if (seen >= target)
+      return b ? (1u << b) - 1 : 0;
+  }
+  return h->max_us;
+}
+
+void trace_dump(void) {
+  trace_histogram_t copy;
+
+  printf("%-13s %7s %8s %8s %8s %8s %8s\n", "etapa (us)", "n", "min", "media", "p50<=", "p99<=", "max");
+  for (uint8_t s = 0; s < TRACE_STAGE_COUNT; s++) {
+    taskENTER_CRITICAL();
+    copy = histograms[s];
+    taskEXIT_CRITICAL();
+
+    if (copy.count == 0) {
+      printf("%-13s %7u\n", stage_names[s], 0u);
+      continue;
+    }
+    printf("%-13s %7lu %8lu %8lu %8lu %8lu %8lu\n", stage_names[s],
+           (unsigned long)copy.count, (unsigned long)copy.min_us,
+           (unsigned long)(copy.sum_us / copy.count),
+           (unsigned long)trace_percentile(&copy, 50), (unsigned long)trace_percentile(&copy, 99),
+           (unsigned long)copy.max_us);
+  }
+
+#if configGENERATE_RUN_TIME_STATS
+  // Tempo de CPU (contador de 1 us) e menor folga de pilha (em palavras) de cada tarefa.
+  // O vetor é estático: vTaskGetRunTimeStats alocaria a lista de tarefas no heap.
+  static TaskStatus_t tasks[TRACE_MAX_TASKS];
+  configRUN_TIME_COUNTER_TYPE total;
+  UBaseType_t count = uxTaskGetSystemState(tasks, TRACE_MAX_TASKS, &total);
+
+  printf("%-16s %12s %5s %8s\n", "tarefa", "tempo (us)", "cpu", "pilha");
+  for (UBaseType_t t = 0; t < count; t++) {
+    printf("%-16s %12llu %4lu%% %8lu\n", tasks[t].pcTaskName, (unsigned long long)tasks[t].ulRunTimeCounter,
+           (unsigned long)(total ? tasks[t].ulRunTimeCounter * 100 / total : 0),
+           (unsigned long)tasks[t].usStackHighWaterMark);
+  }
+#endif
+}
+
+void trace_reset(void) {
+  taskENTER_CRITICAL();
+  memset(histograms, 0, sizeof(histograms));
+  taskEXIT_CRITICAL();
+}
@@ -0,0 +1,50 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+// Medição de latência do caminho botão → display, por etapa.
+// As marcações de tempo usam o contador de 1 us (hal_time_us32) e cada etapa mantém um
+// histograma de tamanho fixo com faixas em potências de 2 (1, 2, 4, ... us).
+
+#include <stdint.h>
+#include "hal.h"
+
+#define TRACE_BUCKETS 24 // Última faixa: >= 2^22 us (~4 s)
+#define TRACE_MAX_TASKS 16 // Tarefas listadas no uso de CPU
+
+typedef enum {
+  TRACE_GATE_QUEUE,      // Interrupção do botão → tarefa do portão acordada (fila)
+  TRACE_GATE_QUEUE_BUSY, // Idem, para eventos ocorridos durante o desenho/envio do display
+  TRACE_PARKING_MUTEX,   // Espera pelo mutex das zonas
+  TRACE_DISPLAY_QUEUE,   // Comando enfileirado → aplicado pela tarefa do display
+  TRACE_RENDER,          // Tarefa do display acordada → início do envio I2C
+  TRACE_FLUSH,           // Início do envio I2C → DMA concluído (ver abaixo)
+  TRACE_TOTAL,           // Interrupção do botão → DMA do envio do contador concluído
+  TRACE_STAGE_COUNT
+} trace_stage_t;
+
+// TRACE_FLUSH e TRACE_TOTAL terminam na interrupção de fim do DMA, quando o último byte entra
+// na FIFO do I2C: os até 16 bytes ainda na FIFO (~0,4 ms a 400 kHz) ficam fora da medição.
+// Esperar o barramento ocioso ali prenderia a interrupção durante esse tempo.
+
+typedef struct {
+  uint32_t count;
+  uint32_t min_us;
+  uint32_t max_us;
+  uint64_t sum_us;
+  uint32_t buckets[TRACE_BUCKETS];
+} trace_histogram_t;
+
+static inline uint32_t trace_now(void) {
+  return hal_time_us32();
+}
+
+// Registra a duração de uma etapa (pode ser chamada de tarefas e de interrupções)
+void trace_record(trace_stage_t stage, uint32_t start_us, uint32_t end_us);
+
+// Imprime os histogramas e o uso de CPU e de pilha por tarefa
+void trace_dump(void);
+
+// Zera os histogramas
+void trace_reset(void);
+
+#endif
@@ -0,0 +1,17 @@
+#include "ui_layout.h"
+
+void ui_draw_main(ssd1306_t *ssd) {
+  ssd1306_rect(ssd, 3, 3, 122, 60, true, false);
+  ssd1306_line(ssd, 3, 15, 123, 15, true); // linha horizontal - primeira
+  ssd1306_line(ssd, 3, 40, 123, 40, true); // linha horizontal - segunda
+  ssd1306_line(ssd, 53, 15, 53, 40, true); // linha vertical
+  ssd1306_draw_string(ssd, "Estacionamento", 9, 6);
+  ssd1306_draw_string(ssd, "Vagas", 9, 20);
+  ssd1306_draw_string(ssd, "Disp.", 9, 30);
+}
+
+// Telas renderizadas pelo gerador; para uma nova tela fixa basta acrescentá-la aqui
+const ui_layout_t ui_layouts[] = {
+  { "main", ui_draw_main },
+};
+const uint8_t ui_layout_count = sizeof(ui_layouts) / sizeof(ui_layouts[0]);
@@ -0,0 +1,21 @@
+#ifndef UI_LAYOUT_H
+#define UI_LAYOUT_H
+
+// Telas fixas do display, descritas com as primitivas de desenho do ssd1306.
+// Não são desenhadas no boot: host/render_screens.c as renderiza para imagens prontas
+// em lib/ui_screens.h, carregadas com ssd1306_load.
+
+#include "ssd1306.h"
+
+typedef struct {
+  const char *name; // Nome da imagem gerada (ui_screen_<name>)
+  void (*draw)(ssd1306_t *ssd);
+} ui_layout_t;
+
+// Tela principal: moldura, título e rótulos do contador de vagas
+void ui_draw_main(ssd1306_t *ssd);
+
+extern const ui_layout_t ui_layouts[];
+extern const uint8_t ui_layout_count;
+
+#endif
@@ -0,0 +1,51 @@
+#include "ui_number.h"
+#include <string.h>
+
+void ui_number_init(ui_number_t *number, uint8_t x, uint8_t y, uint8_t digits, const ssd1306_font_t *font,
+                    uint8_t scale) {
+  number->x = x;
+  number->y = y;
+  number->font = font;
+  number->scale = scale;
+  number->digits = digits < UI_NUMBER_MAX_DIGITS ? digits : UI_NUMBER_MAX_DIGITS;
+  memset(number->cells, 0, sizeof(number->cells));
+}
+
+// Apaga a célula e desenha o glifo centralizado nela (dígitos proporcionais, como o '1',
+// são mais estreitos que a célula)
+static void ui_number_draw_cell(ui_number_t *number, ssd1306_t *ssd, uint8_t cell, char c) {
+  const uint8_t *columns;
+  uint8_t cell_width = ui_number_cell_width(number);
+  uint8_t x = number->x + cell * cell_width;
+  uint8_t glyph_width = font_glyph(number->font, c, &columns);
+
+  ssd1306_rect(ssd, number->y, x, cell_width, number->font->height * number->scale, false, true);
+  ssd1306_draw_glyph(ssd, number->font, c, x + (number->font->width - glyph_width) / 2 * number->scale, number->y,
+                     number->scale);
+}
+
+void ui_number_set(ui_number_t *number, ssd1306_t *ssd, uint16_t value) {
+  // Da direita para a esquerda; as células à esquerda do número ficam em branco (o zero
+  // é exibido na última célula)
+  for (int8_t i = number->digits - 1; i >= 0; i--) {
+    char c = ' ';
+    if (value > 0 || i == number->digits - 1) {
+      c = '0' + value % 10;
+      value /= 10;
+    }
+
+    if (number->cells[i] != c) {
+      ui_number_draw_cell(number, ssd, i, c);
+      number->cells[i] = c;
+    }
+  }
+}
+
+uint8_t ui_number_digits(uint16_t value) {
+  uint8_t digits = 1;
+  while (value >= 10) {
+    value /= 10;
+    digits++;
+  }
+  return digits;
+}
@@ -0,0 +1,35 @@
+#ifndef UI_NUMBER_H
+#define UI_NUMBER_H
+
+// Campo numérico de largura fixa no display: dígitos alinhados à direita, um por célula (a
+// largura máxima da fonte, na escala do campo). O campo guarda o caractere já desenhado em
+// cada célula e redesenha apenas as células que mudaram, direto da tabela de glifos (sem sprintf).
+
+#include "ssd1306.h"
+
+#define UI_NUMBER_MAX_DIGITS 5 // uint16_t
+
+typedef struct {
+  uint8_t x, y;                     // Canto superior esquerdo da primeira célula
+  uint8_t digits;                   // Número de células
+  const ssd1306_font_t *font;
+  uint8_t scale;                    // Ampliação dos glifos (1 a SSD1306_FONT_MAX_SCALE)
+  char cells[UI_NUMBER_MAX_DIGITS]; // Conteúdo já desenhado ('\0' = desconhecido)
+} ui_number_t;
+
+// Prepara o campo; o primeiro ui_number_set desenha todas as células
+void ui_number_init(ui_number_t *number, uint8_t x, uint8_t y, uint8_t digits, const ssd1306_font_t *font,
+                    uint8_t scale);
+
+// Largura de uma célula do campo em pixels
+static inline uint8_t ui_number_cell_width(const ui_number_t *number) {
+  return (number->font->width + number->font->spacing) * number->scale;
+}
+
+// Exibe 'value' (sem zeros à esquerda), redesenhando apenas as células alteradas
+void ui_number_set(ui_number_t *number, ssd1306_t *ssd, uint16_t value);
+
+// Número de dígitos de 'value' (largura necessária para exibi-lo)
+uint8_t ui_number_digits(uint16_t value);
+
+#endif
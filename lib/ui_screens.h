@@ -0,0 +1,77 @@
+#ifndef UI_SCREENS_H
+#define UI_SCREENS_H
+
+// Gerado por host/render_screens.c a partir de lib/ui_layout.c. Não editar.
+// Cada imagem tem o formato de ssd1306_t.ram_buffer sem o byte de controle:
+// 8 páginas por coluna, coluna a coluna (endereçamento vertical).
+
+#include <stdint.h>
+
+static const uint8_t ui_screen_main[1024] = {
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xF8, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x7F,
+  0x08, 0x80, 0x00, 0x00, 0x00, 0x01, 0x00, 0x40, 0x08, 0x80, 0x00, 0x00, 0x00, 0x01, 0x00, 0x40,
+  0x08, 0x80, 0x00, 0x00, 0x00, 0x01, 0x00, 0x40, 0x08, 0x80, 0x00, 0x00, 0x00, 0x01, 0x00, 0x40,
+  0x08, 0x80, 0x00, 0x00, 0x00, 0x01, 0x00, 0x40, 0xC8, 0x9F, 0xF0, 0xC1, 0x1F, 0x01, 0x00, 0x40,
+  0xC8, 0x9F, 0xF0, 0xC3, 0x1F, 0x01, 0x00, 0x40, 0x48, 0x92, 0x00, 0x46, 0x10, 0x01, 0x00, 0x40,
+  0x48, 0x92, 0x00, 0x46, 0x10, 0x01, 0x00, 0x40, 0x48, 0x92, 0x00, 0xC6, 0x18, 0x01, 0x00, 0x40,
+  0x48, 0x90, 0xF0, 0x83, 0x0F, 0x01, 0x00, 0x40, 0x48, 0x90, 0xF0, 0x01, 0x07, 0x01, 0x00, 0x40,
+  0x08, 0x80, 0x00, 0x00, 0x00, 0x01, 0x00, 0x40, 0x08, 0x92, 0x00, 0x02, 0x00, 0x01, 0x00, 0x40,
+  0x08, 0x97, 0x40, 0x07, 0x00, 0x01, 0x00, 0x40, 0x08, 0x95, 0x40, 0x05, 0x11, 0x01, 0x00, 0x40,
+  0x08, 0x95, 0x40, 0x45, 0x1F, 0x01, 0x00, 0x40, 0x08, 0x95, 0x40, 0x45, 0x1F, 0x01, 0x00, 0x40,
+  0x08, 0x9D, 0xC0, 0x07, 0x10, 0x01, 0x00, 0x40, 0x08, 0x89, 0x80, 0x07, 0x00, 0x01, 0x00, 0x40,
+  0x08, 0x80, 0x00, 0x00, 0x00, 0x01, 0x00, 0x40, 0x08, 0x80, 0x80, 0x09, 0x12, 0x01, 0x00, 0x40,
+  0x08, 0x81, 0xC0, 0x0B, 0x17, 0x01, 0x00, 0x40, 0x08, 0x81, 0x40, 0x0A, 0x15, 0x01, 0x00, 0x40,
+  0xC8, 0x8F, 0x40, 0x0A, 0x15, 0x01, 0x00, 0x40, 0xC8, 0x9F, 0x40, 0x0A, 0x15, 0x01, 0x00, 0x40,
+  0x08, 0x91, 0xC0, 0x0F, 0x1D, 0x01, 0x00, 0x40, 0x08, 0x91, 0xC0, 0x07, 0x09, 0x01, 0x00, 0x40,
+  0x08, 0x80, 0x00, 0x00, 0x00, 0x01, 0x00, 0x40, 0x08, 0x88, 0x00, 0x02, 0x3F, 0x01, 0x00, 0x40,
+  0x08, 0x9D, 0x40, 0x07, 0x3F, 0x01, 0x00, 0x40, 0x08, 0x95, 0x40, 0x05, 0x09, 0x01, 0x00, 0x40,
+  0x08, 0x95, 0x40, 0x05, 0x09, 0x01, 0x00, 0x40, 0x08, 0x95, 0x40, 0x05, 0x09, 0x01, 0x00, 0x40,
+  0x08, 0x9F, 0xC0, 0x07, 0x0F, 0x01, 0x00, 0x40, 0x08, 0x9E, 0x80, 0x07, 0x06, 0x01, 0x00, 0x40,
+  0x08, 0x80, 0x00, 0x00, 0x00, 0x01, 0x00, 0x40, 0x08, 0x8E, 0x80, 0x04, 0x00, 0x01, 0x00, 0x40,
+  0x08, 0x9F, 0xC0, 0x05, 0x00, 0x01, 0x00, 0x40, 0x08, 0x91, 0x40, 0x05, 0x00, 0x01, 0x00, 0x40,
+  0x08, 0x91, 0x40, 0x05, 0x18, 0x01, 0x00, 0x40, 0x08, 0x91, 0x40, 0x05, 0x18, 0x01, 0x00, 0x40,
+  0x08, 0x9B, 0x40, 0x07, 0x00, 0x01, 0x00, 0x40, 0x08, 0x8A, 0x40, 0x02, 0x00, 0x01, 0x00, 0x40,
+  0x08, 0x80, 0x00, 0x00, 0x00, 0x01, 0x00, 0x40, 0x08, 0x80, 0x00, 0x00, 0x00, 0x01, 0x00, 0x40,
+  0x08, 0x80, 0x00, 0x00, 0x00, 0x01, 0x00, 0x40, 0x08, 0x91, 0x00, 0x00, 0x00, 0x01, 0x00, 0x40,
+  0x48, 0x9F, 0x00, 0x00, 0x00, 0x01, 0x00, 0x40, 0x48, 0x9F, 0xFF, 0xFF, 0xFF, 0x01, 0x00, 0x40,
+  0x08, 0x90, 0x00, 0x00, 0x00, 0x01, 0x00, 0x40, 0x08, 0x80, 0x00, 0x00, 0x00, 0x01, 0x00, 0x40,
+  0x08, 0x80, 0x00, 0x00, 0x00, 0x01, 0x00, 0x40, 0x08, 0x8E, 0x00, 0x00, 0x00, 0x01, 0x00, 0x40,
+  0x08, 0x9F, 0x00, 0x00, 0x00, 0x01, 0x00, 0x40, 0x08, 0x91, 0x00, 0x00, 0x00, 0x01, 0x00, 0x40,
+  0x08, 0x91, 0x00, 0x00, 0x00, 0x01, 0x00, 0x40, 0x08, 0x91, 0x00, 0x00, 0x00, 0x01, 0x00, 0x40,
+  0x08, 0x9F, 0x00, 0x00, 0x00, 0x01, 0x00, 0x40, 0x08, 0x8E, 0x00, 0x00, 0x00, 0x01, 0x00, 0x40,
+  0x08, 0x80, 0x00, 0x00, 0x00, 0x01, 0x00, 0x40, 0x08, 0x9F, 0x00, 0x00, 0x00, 0x01, 0x00, 0x40,
+  0x08, 0x9F, 0x00, 0x00, 0x00, 0x01, 0x00, 0x40, 0x08, 0x81, 0x00, 0x00, 0x00, 0x01, 0x00, 0x40,
+  0x08, 0x81, 0x00, 0x00, 0x00, 0x01, 0x00, 0x40, 0x08, 0x81, 0x00, 0x00, 0x00, 0x01, 0x00, 0x40,
+  0x08, 0x9F, 0x00, 0x00, 0x00, 0x01, 0x00, 0x40, 0x08, 0x9E, 0x00, 0x00, 0x00, 0x01, 0x00, 0x40,
+  0x08, 0x80, 0x00, 0x00, 0x00, 0x01, 0x00, 0x40, 0x08, 0x88, 0x00, 0x00, 0x00, 0x01, 0x00, 0x40,
+  0x08, 0x9D, 0x00, 0x00, 0x00, 0x01, 0x00, 0x40, 0x08, 0x95, 0x00, 0x00, 0x00, 0x01, 0x00, 0x40,
+  0x08, 0x95, 0x00, 0x00, 0x00, 0x01, 0x00, 0x40, 0x08, 0x95, 0x00, 0x00, 0x00, 0x01, 0x00, 0x40,
+  0x08, 0x9F, 0x00, 0x00, 0x00, 0x01, 0x00, 0x40, 0x08, 0x9E, 0x00, 0x00, 0x00, 0x01, 0x00, 0x40,
+  0x08, 0x80, 0x00, 0x00, 0x00, 0x01, 0x00, 0x40, 0x08, 0x9F, 0x00, 0x00, 0x00, 0x01, 0x00, 0x40,
+  0x08, 0x9F, 0x00, 0x00, 0x00, 0x01, 0x00, 0x40, 0x08, 0x86, 0x00, 0x00, 0x00, 0x01, 0x00, 0x40,
+  0x08, 0x9E, 0x00, 0x00, 0x00, 0x01, 0x00, 0x40, 0x08, 0x87, 0x00, 0x00, 0x00, 0x01, 0x00, 0x40,
+  0x08, 0x9F, 0x00, 0x00, 0x00, 0x01, 0x00, 0x40, 0x08, 0x9E, 0x00, 0x00, 0x00, 0x01, 0x00, 0x40,
+  0x08, 0x80, 0x00, 0x00, 0x00, 0x01, 0x00, 0x40, 0x08, 0x8E, 0x00, 0x00, 0x00, 0x01, 0x00, 0x40,
+  0x08, 0x9F, 0x00, 0x00, 0x00, 0x01, 0x00, 0x40, 0x08, 0x95, 0x00, 0x00, 0x00, 0x01, 0x00, 0x40,
+  0x08, 0x95, 0x00, 0x00, 0x00, 0x01, 0x00, 0x40, 0x08, 0x95, 0x00, 0x00, 0x00, 0x01, 0x00, 0x40,
+  0x08, 0x97, 0x00, 0x00, 0x00, 0x01, 0x00, 0x40, 0x08, 0x86, 0x00, 0x00, 0x00, 0x01, 0x00, 0x40,
+  0x08, 0x80, 0x00, 0x00, 0x00, 0x01, 0x00, 0x40, 0x08, 0x9F, 0x00, 0x00, 0x00, 0x01, 0x00, 0x40,
+  0x08, 0x9F, 0x00, 0x00, 0x00, 0x01, 0x00, 0x40, 0x08, 0x81, 0x00, 0x00, 0x00, 0x01, 0x00, 0x40,
+  0x08, 0x81, 0x00, 0x00, 0x00, 0x01, 0x00, 0x40, 0x08, 0x81, 0x00, 0x00, 0x00, 0x01, 0x00, 0x40,
+  0x08, 0x9F, 0x00, 0x00, 0x00, 0x01, 0x00, 0x40, 0x08, 0x9E, 0x00, 0x00, 0x00, 0x01, 0x00, 0x40,
+  0x08, 0x80, 0x00, 0x00, 0x00, 0x01, 0x00, 0x40, 0x08, 0x80, 0x00, 0x00, 0x00, 0x01, 0x00, 0x40,
+  0x08, 0x81, 0x00, 0x00, 0x00, 0x01, 0x00, 0x40, 0x08, 0x81, 0x00, 0x00, 0x00, 0x01, 0x00, 0x40,
+  0xC8, 0x8F, 0x00, 0x00, 0x00, 0x01, 0x00, 0x40, 0xC8, 0x9F, 0x00, 0x00, 0x00, 0x01, 0x00, 0x40,
+  0x08, 0x91, 0x00, 0x00, 0x00, 0x01, 0x00, 0x40, 0x08, 0x91, 0x00, 0x00, 0x00, 0x01, 0x00, 0x40,
+  0x08, 0x80, 0x00, 0x00, 0x00, 0x01, 0x00, 0x40, 0x08, 0x8E, 0x00, 0x00, 0x00, 0x01, 0x00, 0x40,
+  0x08, 0x9F, 0x00, 0x00, 0x00, 0x01, 0x00, 0x40, 0x08, 0x91, 0x00, 0x00, 0x00, 0x01, 0x00, 0x40,
+  0x08, 0x91, 0x00, 0x00, 0x00, 0x01, 0x00, 0x40, 0x08, 0x91, 0x00, 0x00, 0x00, 0x01, 0x00, 0x40,
+  0x08, 0x9F, 0x00, 0x00, 0x00, 0x01, 0x00, 0x40, 0x08, 0x8E, 0x00, 0x00, 0x00, 0x01, 0x00, 0x40,
+  0x08, 0x80, 0x00, 0x00, 0x00, 0x01, 0x00, 0x40, 0x08, 0x80, 0x00, 0x00, 0x00, 0x01, 0x00, 0x40,
+  0x08, 0x80, 0x00, 0x00, 0x00, 0x01, 0x00, 0x40, 0x08, 0x80, 0x00, 0x00, 0x00, 0x01, 0x00, 0x40,
+  0xF8, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x7F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+};
+
+#endif
@@ -1,20 +1,39 @@
-#include "pico/stdlib.h"
-#include "hardware/i2c.h"
-#include "hardware/pwm.h"
+#include "lib/hal.h"
 #include "lib/ssd1306.h"
-#include "lib/font.h"
+#include "lib/ui_screens.h"
+#include "lib/ui_number.h"
+#include "lib/parking.h"
+#include "lib/event_log.h"
+#include "lib/admission.h"
+#include "lib/trace.h"
+#include "lib/telemetry.h"
+#include "lib/buzzer.h"
 #include "FreeRTOS.h"
 #include "FreeRTOSConfig.h"
 #include "task.h"
 #include "queue.h"
 #include "semphr.h"
+#include "timers.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
-// Define o máximo de carros no estacionamento
-#define PARKING_MAX 8
-volatile uint16_t parking_counter = 0;
+// Zonas (níveis) do estacionamento e a capacidade de cada uma; o total é a soma das zonas
+parking_zone_t parking_zones[] = {
+    { .name = "N1", .capacity = 4 },
+    { .name = "N2", .capacity = 4 },
+};
+#define PARKING_ZONE_COUNT (sizeof(parking_zones) / sizeof(parking_zones[0]))
+parking_lot_t parking_lot;
+
+// Registro persistente dos eventos de ocupação (flash), gravado pela tarefa vEventLogTask. Os
+// eventos do setor em montagem também são gravados periodicamente, limitando a perda de eventos
+// em uma queda de energia.
+#define EVENT_LOG_SYNC_MS (5 * 60 * 1000)
+event_log_t parking_log;
+
+// Admissão: semáforo de contagem das vagas livres e mutex das zonas e do registro
+admission_t admission;
 
 #define BTN_B_PIN 6
 #define BTN_A_PIN 5
@@ -26,31 +45,183 @@ volatile uint16_t parking_counter = 0;
 #define LED_BLUE 12
 
 // Definição de macros para o protocolo I2C (SSD1306)
-#define I2C_PORT i2c1
+#define I2C_PORT HAL_I2C1
 #define I2C_SDA 14
 #define I2C_SCL 15
 #define SSD1306_ADDRESS 0x3C
 
 // Criação das variáveis que receberão os semáforos
-SemaphoreHandle_t xDisplayMutex;
-SemaphoreHandle_t xCounterSemaphore;
-SemaphoreHandle_t xResetBiSemaphore;
-SemaphoreHandle_t xEntranceBiSemaphore;
-SemaphoreHandle_t xExitBiSemaphore;
-
-// Define variáveis para debounce dos botões
-volatile uint32_t last_time_btn_press = 0;
-const uint32_t debounce_delay_ms = 260;
+SemaphoreHandle_t xDisplayFlushSemaphore;
+
+// Identificação das entradas (portões) que geram eventos
+typedef enum {
+    GATE_ENTRANCE, // Botão A
+    GATE_EXIT,     // Botão B
+    GATE_RESET,    // Botão SW
+    GATE_COUNT
+} gate_t;
+
+// Evento registrado pela interrupção: portão, borda e instante (us desde o boot)
+typedef struct {
+    uint32_t timestamp_us;
+    uint8_t gate;
+    uint8_t edge;
+    bool display_busy; // O display estava desenhando/enviando quando o evento ocorreu
+} gate_event_t;
+
+// Filas de eventos por portão, dimensionadas para rajadas de chegadas.
+// Eventos só são perdidos se a fila encher, e nesse caso são contabilizados.
+#define GATE_QUEUE_LENGTH 32
+#define GATE_BATCH_MAX 8
+QueueHandle_t xEntranceQueue;
+QueueHandle_t xExitQueue;
+QueueHandle_t xResetQueue;
+volatile uint32_t gate_event_overflows = 0;
+
+// Eventos tratados por cada tarefa de portão (cada contador é escrito só pela sua tarefa).
+// 'accepted' conta as entradas admitidas, as saídas efetivadas e os resets.
+typedef struct {
+    volatile uint32_t processed;
+    volatile uint32_t accepted;
+} gate_stats_t;
+gate_stats_t gate_stats[GATE_COUNT];
+volatile uint32_t gate_processed_us = 0; // Fim do tratamento do último lote de eventos
+
+// Injeção de eventos sintéticos pelo console: "i <padrao> [n] [intervalo_us]"
+#define INJECT_PATTERN_MAX 24
+#define INJECT_LINE_MAX (INJECT_PATTERN_MAX + 24)
+#define INJECT_DRAIN_TIMEOUT_MS 5000
+#define CONSOLE_POLL_MS 10
+
+// Tipos de comando de desenho consumidos pela tarefa do display
+typedef enum {
+    DISPLAY_CMD_COUNTER,        // Atualiza o número de vagas disponíveis
+    DISPLAY_CMD_OVERLAY,        // Exibe um texto temporário na faixa de mensagens por 'duration_ms'
+    DISPLAY_CMD_OVERLAY_EXPIRE  // Remove os textos temporários vencidos (timer dos overlays)
+} display_cmd_type_t;
+
+// Comando de desenho compacto enviado pelas tarefas produtoras
+#define DISPLAY_TEXT_MAX 16
+typedef struct {
+    uint8_t type;
+    uint8_t x, y;
+    uint16_t duration_ms;
+    char text[DISPLAY_TEXT_MAX];
+    uint32_t origin_us; // Instante da interrupção que originou o comando (0 se nenhuma)
+    uint32_t posted_us; // Instante em que o comando entrou na fila
+} display_cmd_t;
+
+// Fila de comandos de desenho; apenas vDisplayTask acessa o display
+#define DISPLAY_QUEUE_LENGTH 16
+QueueHandle_t xDisplayQueue;
+volatile uint32_t display_dropped_cmds = 0;
+
+// Marcações do envio em andamento (lidas em display_flush_done)
+uint32_t display_flush_start_us = 0;
+uint32_t display_flush_origin_us = 0;
+
+// Mensagens temporárias (overlays) na faixa das linhas 42..60. Formam uma pilha: a mais recente
+// é exibida e, quando vence, volta a anterior ainda válida (ou a faixa é apagada).
+// Acessadas apenas por vDisplayTask; o timer apenas avisa a tarefa do display pela fila.
+#define OVERLAY_MAX 4
+#define OVERLAY_X 5
+#define OVERLAY_Y 42
+#define OVERLAY_W 118
+#define OVERLAY_H 19
+#define OVERLAY_RETRY_MS 10
+typedef struct {
+    char text[DISPLAY_TEXT_MAX];
+    uint8_t x, y;
+    TickType_t expires;
+} overlay_t;
+overlay_t overlays[OVERLAY_MAX];
+uint8_t overlay_count = 0;
+TimerHandle_t xOverlayTimer;
+bool overlay_timer_lost = false; // Vencimento não agendado: a tarefa do display confere sozinha
+
+// Campos do contador (tela principal): vagas livres "N de T" e, abaixo, as vagas livres de
+// cada zona (as que couberem em COUNTER_ZONES_MAX_CHARS células)
+#define COUNTER_X 64
+#define COUNTER_Y 20
+#define COUNTER_ZONES_Y 30
+#define COUNTER_ZONES_MAX_CHARS 8
+ui_number_t counter_free;
+ui_number_t counter_zones[PARKING_ZONE_COUNT];
+uint8_t counter_zone_fields = 0;
+
+// Telemetria binária: intervalo entre os esvaziamentos dos anéis e entre as amostras periódicas
+// (ocupação das zonas, tarefas e contadores de perdas)
+#define TELEMETRY_PERIOD_MS 20
+#define TELEMETRY_SAMPLE_MS 1000
+
+// Marcos do boot (us desde o reset), impressos no boot e pelo comando 't' do console
+uint64_t boot_scheduler_us = 0;
+uint64_t boot_first_frame_us = 0;
+
+// Verdadeiro do início do desenho de um lote até o fim do seu envio ao display
+volatile bool display_busy = false;
+
+// Sons do buzzer: beep único (vaga indisponível) e beep duplo (reset)
+static const buzzer_pattern_t BEEP_SINGLE = { .tone = BUZZER_TONE_BEEP, .on_ms = 100, .off_ms = 0,   .repeat = 1 };
+static const buzzer_pattern_t BEEP_DOUBLE = { .tone = BUZZER_TONE_BEEP, .on_ms = 100, .off_ms = 100, .repeat = 2 };
+
+// Núcleos de cada grupo de tarefas no modo SMP (PARKING_SMP): os eventos dos portões ficam no
+// núcleo 0 e a E/S lenta (display/I2C) no núcleo 1
+#define CORE_EVENTS  (1 << 0)
+#define CORE_OUTPUTS (1 << 1)
+
+// Período de amostragem do debounce de cada entrada (ms)
+#define DEBOUNCE_BTN_A_MS  20
+#define DEBOUNCE_BTN_B_MS  20
+#define DEBOUNCE_BTN_SW_MS 40
+
+// Estado do debounce de uma entrada: após aceitar uma borda, a interrupção do pino fica
+// desabilitada e o timer amostra o nível a cada janela. Ela só volta depois de o botão ser
+// lido solto em duas amostras seguidas, descartando os repiques do aperto e da soltura.
+typedef struct {
+    uint gpio;
+    uint8_t gate;
+    uint32_t window_ms;
+    QueueHandle_t *queue;
+    TimerHandle_t timer;
+    StaticTimer_t timer_buffer;
+    bool released; // Solto na última amostra
+} debounce_input_t;
+
+// Fila de cada portão, indexada por gate_t (usada pela injeção de eventos)
+QueueHandle_t *const gate_queues[GATE_COUNT] = { &xEntranceQueue, &xExitQueue, &xResetQueue };
+
+debounce_input_t debounce_inputs[] = {
+    { BTN_A_PIN,  GATE_ENTRANCE, DEBOUNCE_BTN_A_MS,  &xEntranceQueue },
+    { BTN_B_PIN,  GATE_EXIT,     DEBOUNCE_BTN_B_MS,  &xExitQueue },
+    { BTN_SW_PIN, GATE_RESET,    DEBOUNCE_BTN_SW_MS, &xResetQueue },
+};
+#define DEBOUNCE_INPUT_COUNT (sizeof(debounce_inputs) / sizeof(debounce_inputs[0]))
 
 // Inicializa instância do display OLED
 ssd1306_t ssd;
 
-// pwm
-uint32_t clock   = 125000000;
-uint32_t divider = 0;
-uint32_t wrap    = 0;
-uint slice_num   = 0;
-uint channel_num = 0;
+// Memória estática dos objetos do FreeRTOS: nenhum é criado no heap, então o uso de RAM é
+// conhecido na ligação (com PARKING_STATIC_MEMORY o heap nem existe)
+#define TASK_STACK_DEPTH configMINIMAL_STACK_SIZE
+#define CONSOLE_STACK_DEPTH (configMINIMAL_STACK_SIZE * 2)
+StackType_t entrance_stack[TASK_STACK_DEPTH], leave_stack[TASK_STACK_DEPTH], reset_stack[TASK_STACK_DEPTH];
+StackType_t display_stack[TASK_STACK_DEPTH], console_stack[CONSOLE_STACK_DEPTH], telemetry_stack[TASK_STACK_DEPTH];
+StackType_t event_log_stack[TASK_STACK_DEPTH];
+StaticTask_t entrance_tcb, leave_tcb, reset_tcb, display_tcb, console_tcb, telemetry_tcb, event_log_tcb;
+StaticSemaphore_t display_flush_semaphore_buffer;
+uint8_t entrance_queue_storage[GATE_QUEUE_LENGTH * sizeof(gate_event_t)];
+uint8_t exit_queue_storage[GATE_QUEUE_LENGTH * sizeof(gate_event_t)];
+uint8_t reset_queue_storage[GATE_QUEUE_LENGTH * sizeof(gate_event_t)];
+uint8_t display_queue_storage[DISPLAY_QUEUE_LENGTH * sizeof(display_cmd_t)];
+StaticQueue_t entrance_queue_buffer, exit_queue_buffer, reset_queue_buffer, display_queue_buffer;
+StaticTimer_t overlay_timer_buffer, event_log_timer_buffer;
+
+// Tarefas do próprio kernel (ociosa e serviço dos timers)
+StackType_t idle_stack[configNUMBER_OF_CORES][configMINIMAL_STACK_SIZE];
+StaticTask_t idle_tcb[configNUMBER_OF_CORES];
+StackType_t timer_task_stack[configTIMER_TASK_STACK_DEPTH];
+StaticTask_t timer_task_tcb;
 
 // Inicializa os periféricos da placa
 void peripheral_initialization();
@@ -58,12 +229,6 @@ void peripheral_initialization();
 // Realiza a inicialização dos botões
 void btn_setup(uint gpio);
 
-// Inicializa o buzzer
-void buzzer_setup();
-
-// Cálculo dos paramêtros do PWM para buzzer emitir frequência especificada
-void pwm_set_frequency(float frequency);
-
 // Realiza a inicialização dos LEDs RGB
 void led_rgb_setup(uint gpio);
 
@@ -73,77 +238,247 @@ void i2c_setup(uint baud_in_kilo);
 // Realiza a inicialização do display OLED
 void ssd1306_setup(ssd1306_t *ssd_ptr);
 
-// Atualiza o conteúdo do display (contador) e do LED RGB
-void update_counter_led();
+// Inicializa o I2C e o display e envia a tela inicial (executada pela tarefa do display)
+void display_setup();
+
+// Imprime os tempos do boot até o escalonador e até o primeiro quadro
+void boot_report();
+
+// Imprime os contadores de descartes (comandos do display, eventos dos portões, sons do buzzer e
+// eventos do registro)
+void drops_report();
+
+// Posiciona os campos do contador e desenha as suas partes fixas
+void counter_layout();
+
+// Pede à tarefa do display a atualização do contador e do LED RGB. 'origin_us' é o instante
+// da interrupção que causou a mudança (para a medição de latência) ou 0
+void update_counter(uint32_t origin_us);
+
+// Cor do LED RGB conforme a ocupação (executada apenas por vDisplayTask)
+void led_rgb_update();
+
+// Número de vagas ocupadas
+uint16_t parking_occupancy();
+
+// Pede periodicamente a gravação dos eventos pendentes do registro
+void event_log_timer_callback(TimerHandle_t timer);
+
+// Envia de forma assíncrona (DMA) as alterações do display
+void display_flush(uint32_t origin_us);
+
+// Envia um comando de desenho para a tarefa do display sem bloquear
+void display_post(display_cmd_t *cmd);
+
+// Aplica um comando de desenho ao buffer do display
+void display_apply(const display_cmd_t *cmd);
+
+// Chamada ao término do envio assíncrono do display
+void display_flush_done(ssd1306_t *ssd_ptr, void *ctx);
 
 // Inicializa a função que realiza tratamento das interrupções dos botões
 void gpio_irq_handler(uint gpio, uint32_t events);
 
-// Exibe mensagem temporária no display
-void show_message(const char *message, uint8_t x, uint8_t y, uint32_t delay_ms);
+// Cria os timers de debounce e habilita as interrupções dos botões
+void debounce_setup();
 
-// Inicializa os periféricos da placa
-void peripheral_initialization();
+// Amostra do debounce: renova a janela ou reabilita a interrupção do pino
+void debounce_timer_callback(TimerHandle_t timer);
+
+// Aguarda um evento do portão e retira da fila os demais já pendentes (até 'max')
+uint8_t gate_receive_batch(QueueHandle_t queue, gate_event_t *events, uint8_t max);
 
-// função que faz com que o buzzer emita um som
-void buzzer_sound();
+// Contabiliza um lote tratado pela tarefa do portão
+void gate_stats_update(gate_t gate, uint8_t processed, uint8_t accepted);
+
+// Exibe uma mensagem temporária no display sem bloquear (apagada após 'duration_ms')
+void display_overlay(const char *message, uint8_t x, uint8_t y, uint16_t duration_ms);
+
+// Empilha uma mensagem temporária (executada apenas por vDisplayTask)
+void overlay_push(const display_cmd_t *cmd);
+
+// Descarta as mensagens vencidas, redesenha a faixa e agenda o próximo vencimento
+void overlay_refresh();
+
+// Vencimento da mensagem exibida: pede à tarefa do display que atualize a faixa
+void overlay_timer_callback(TimerHandle_t timer);
+
+// Fixa a tarefa nos núcleos indicados (apenas no modo SMP)
+void task_pin(TaskHandle_t task, UBaseType_t core_mask);
 
 // Implementa a tarefa de entrada de carro (botão A)
-void vEntranceTask();
+void vEntranceTask(void *params);
 
 // Implementa a tarefa de saída de carro (botão B)
-void vLeaveTask();
+void vLeaveTask(void *params);
 
 // Implementa a tarefa de resetar o sistema (botão SW - Joystick)
 void vResetTask();
 
+// Implementa a tarefa dona do display: consome a fila de comandos e envia ao OLED
+void vDisplayTask();
+
+// Implementa a tarefa do console: 't' imprime as latências, o uso de CPU e os tempos do boot, 'z' zera as latências,
+// 'b' liga/desliga a telemetria binária e "i ..." injeta eventos sintéticos nos portões
+void vConsoleTask();
+
+// Interpreta e executa uma linha "i <padrao> [n] [intervalo_us]"
+void inject_command(const char *line);
+
+// Entrega 'count' eventos às filas dos portões a cada 'interval_us', percorrendo o padrão de portões
+// ('e', 's' e 'r') ciclicamente, e informa o resultado
+void inject_events(const char *pattern, uint32_t count, uint32_t interval_us);
+
+// Implementa a tarefa de telemetria: esvazia os anéis em quadros e gera as amostras periódicas
+void vTelemetryTask();
+
+// Registra a ocupação de cada zona, o uso de CPU/pilha das tarefas e os contadores de perdas
+void telemetry_sample();
+
+// Implementa a tarefa de gravação do registro de eventos: a única que apaga e grava a flash
+void vEventLogTask();
+
 int main() {
-    stdio_init_all();
+    hal_init();
 
-    // Inicializa os periféricos
-    peripheral_initialization();
+    // Prepara as zonas do estacionamento e restaura a ocupação registrada na flash
+    if (!parking_init(&parking_lot, parking_zones, PARKING_ZONE_COUNT)) {
+        hal_panic("Capacidade das zonas acima do limite");
+    }
+
+    uint64_t restore_start_us = hal_time_us();
+    if (event_log_init(&parking_log, &parking_lot)) {
+        printf("Registro restaurado: %d vaga(s) ocupada(s), %d evento(s) reaplicado(s) em %lu us\n",
+               parking_lot.occupied, parking_log.restored_records, (unsigned long)(hal_time_us() - restore_start_us));
+    }
+
+    // Cria os semáforos (a contagem de vagas livres inicia com a ocupação restaurada)
+    admission_init(&admission, &parking_lot, &parking_log);
+    xDisplayFlushSemaphore = xSemaphoreCreateBinaryStatic(&display_flush_semaphore_buffer);
+    xSemaphoreGive(xDisplayFlushSemaphore); // Barramento I2C inicia livre
+
+    // Cria as filas de eventos dos portões
+    xEntranceQueue = xQueueCreateStatic(GATE_QUEUE_LENGTH, sizeof(gate_event_t), entrance_queue_storage, &entrance_queue_buffer);
+    xExitQueue = xQueueCreateStatic(GATE_QUEUE_LENGTH, sizeof(gate_event_t), exit_queue_storage, &exit_queue_buffer);
+    xResetQueue = xQueueCreateStatic(GATE_QUEUE_LENGTH, sizeof(gate_event_t), reset_queue_storage, &reset_queue_buffer);
 
-    // Cria os semáforos
-    xCounterSemaphore = xSemaphoreCreateCounting(PARKING_MAX, 0);
-    xDisplayMutex = xSemaphoreCreateMutex();
-    xResetBiSemaphore = xSemaphoreCreateBinary();
-    xEntranceBiSemaphore = xSemaphoreCreateBinary();
-    xExitBiSemaphore = xSemaphoreCreateBinary();
+    // Cria a fila de comandos do display
+    xDisplayQueue = xQueueCreateStatic(DISPLAY_QUEUE_LENGTH, sizeof(display_cmd_t), display_queue_storage, &display_queue_buffer);
+    xOverlayTimer = xTimerCreateStatic("Overlay", 1, pdFALSE, NULL, overlay_timer_callback, &overlay_timer_buffer);
 
-    // Criação das tarefas
-    xTaskCreate(vEntranceTask, "Task: Entrada", configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY, NULL);
-    xTaskCreate(vLeaveTask, "Task: Saida", configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY, NULL);
-    xTaskCreate(vResetTask, "Task: Resetar", configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY, NULL);
+    // Inicializa os periféricos (após as filas que recebem os eventos das interrupções)
+    peripheral_initialization();
+    update_counter(0);
+
+    // Gravação periódica do registro de eventos
+    xTimerStart(xTimerCreateStatic("Registro", pdMS_TO_TICKS(EVENT_LOG_SYNC_MS), pdTRUE, NULL, event_log_timer_callback,
+                                   &event_log_timer_buffer), 0);
+
+    // Criação das tarefas. Cada portão de entrada/saída é uma tarefa com a sua própria fila;
+    // para mais portões basta criar outras tarefas com outras filas.
+    task_pin(xTaskCreateStatic(vEntranceTask, "Task: Entrada", TASK_STACK_DEPTH, &xEntranceQueue, tskIDLE_PRIORITY,
+                               entrance_stack, &entrance_tcb), CORE_EVENTS);
+    task_pin(xTaskCreateStatic(vLeaveTask, "Task: Saida", TASK_STACK_DEPTH, &xExitQueue, tskIDLE_PRIORITY,
+                               leave_stack, &leave_tcb), CORE_EVENTS);
+    task_pin(xTaskCreateStatic(vResetTask, "Task: Resetar", TASK_STACK_DEPTH, NULL, tskIDLE_PRIORITY,
+                               reset_stack, &reset_tcb), CORE_EVENTS);
+    task_pin(xTaskCreateStatic(vDisplayTask, "Task: Display", TASK_STACK_DEPTH, NULL, tskIDLE_PRIORITY,
+                               display_stack, &display_tcb), CORE_OUTPUTS);
+    xTaskCreateStatic(vConsoleTask, "Task: Console", CONSOLE_STACK_DEPTH, NULL, tskIDLE_PRIORITY,
+                      console_stack, &console_tcb);
+    xTaskCreateStatic(vTelemetryTask, "Task: Telem", TASK_STACK_DEPTH, NULL, tskIDLE_PRIORITY,
+                      telemetry_stack, &telemetry_tcb);
+    xTaskCreateStatic(vEventLogTask, "Task: Registro", TASK_STACK_DEPTH, NULL, tskIDLE_PRIORITY,
+                      event_log_stack, &event_log_tcb);
 
     // Chamda do Scheduller de tarefas
+    boot_scheduler_us = hal_time_us();
     vTaskStartScheduler();
-    panic_unsupported();
+    hal_panic("Scheduler encerrado");
 }
 
+// Apenas registra a borda: bloqueia o pino até o debounce confirmar a soltura e enfileira o evento
 void gpio_irq_handler(uint gpio, uint32_t events) {
-    uint32_t current_time = to_ms_since_boot(get_absolute_time()); // retorna o tempo total em ms desde o boot do rp2040
-
-    // verifica se a diff entre o tempo atual e a ultima vez que o botão foi pressionado é maior que o tempo de debounce
-    if (current_time - last_time_btn_press > debounce_delay_ms) {
-        last_time_btn_press = current_time;
-        BaseType_t xHigherPriorityTaskWoken = pdFALSE;
-
-        if (gpio == BTN_A_PIN) {
-            printf("Botão A pressionado!\n");
-            xSemaphoreGiveFromISR(xEntranceBiSemaphore, &xHigherPriorityTaskWoken);
-            portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
-        } else if (gpio == BTN_B_PIN) {
-            printf("Botão B pressionado!\n");
-            xSemaphoreGiveFromISR(xExitBiSemaphore, &xHigherPriorityTaskWoken);
-            portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
-        } else if (gpio == BTN_SW_PIN) {
-            printf("Botão SW pressionado!\n");
-            xSemaphoreGiveFromISR(xResetBiSemaphore, &xHigherPriorityTaskWoken);
-            portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+    for (uint8_t i = 0; i < DEBOUNCE_INPUT_COUNT; i++) {
+        debounce_input_t *input = &debounce_inputs[i];
+        if (input->gpio != gpio) {
+            continue;
+        }
+
+        // Sem o timer (fila de comandos dos timers cheia) a janela nunca terminaria: o pino
+        // continua habilitado, mesmo aceitando eventuais repiques
+        hal_gpio_irq_set_enabled(gpio, HAL_GPIO_EDGE_FALL, false);
+        input->released = false;
+        if (xTimerStartFromISR(input->timer, &xHigherPriorityTaskWoken) != pdPASS) {
+            hal_gpio_irq_set_enabled(gpio, HAL_GPIO_EDGE_FALL, true);
+        }
+
+        gate_event_t event = {
+            .timestamp_us = hal_time_us32(), .gate = input->gate, .edge = events, .display_busy = display_busy
+        };
+        if (xQueueSendToBackFromISR(*input->queue, &event, &xHigherPriorityTaskWoken) != pdTRUE) {
+            gate_event_overflows++;
         }
+        telemetry_emit(TELEMETRY_SRC_GPIO, TELEMETRY_GATE_EVENT, input->gate, events | (display_busy << 8), 0, 0);
+        break;
+    }
+
+    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+
+// Cria os timers de debounce e habilita as interrupções dos botões
+void debounce_setup() {
+    for (uint8_t i = 0; i < DEBOUNCE_INPUT_COUNT; i++) {
+        debounce_input_t *input = &debounce_inputs[i];
+        input->timer = xTimerCreateStatic("Debounce", pdMS_TO_TICKS(input->window_ms), pdFALSE, input,
+                                          debounce_timer_callback, &input->timer_buffer);
+        hal_gpio_irq_enable(input->gpio, HAL_GPIO_EDGE_FALL, &gpio_irq_handler);
     }
 }
 
+// Fim de uma janela de debounce: com o botão pressionado (nível baixo, pull-up) ou solto há
+// menos de uma janela, amostra de novo; solto em duas amostras seguidas, reabilita a interrupção
+// do pino (bordas pendentes são descartadas)
+void debounce_timer_callback(TimerHandle_t timer) {
+    debounce_input_t *input = pvTimerGetTimerID(timer);
+    bool released = hal_gpio_get(input->gpio);
+
+    if (!(released && input->released)) {
+        input->released = released;
+        if (xTimerStart(timer, 0) == pdPASS) {
+            return;
+        }
+    }
+    hal_gpio_irq_set_enabled(input->gpio, HAL_GPIO_EDGE_FALL, true);
+}
+
+// Aguarda um evento do portão e retira da fila os demais já pendentes (até 'max')
+uint8_t gate_receive_batch(QueueHandle_t queue, gate_event_t *events, uint8_t max) {
+    uint8_t count = 0;
+
+    xQueueReceive(queue, &events[count++], portMAX_DELAY);
+    while (count < max && xQueueReceive(queue, &events[count], 0) == pdTRUE) {
+        count++;
+    }
+
+    // Latência de cada evento desde a interrupção até a tarefa acordar
+    uint32_t wake_us = trace_now();
+    for (uint8_t i = 0; i < count; i++) {
+        trace_record(events[i].display_busy ? TRACE_GATE_QUEUE_BUSY : TRACE_GATE_QUEUE, events[i].timestamp_us, wake_us);
+    }
+
+    return count;
+}
+
+// Contabiliza um lote tratado pela tarefa do portão
+void gate_stats_update(gate_t gate, uint8_t processed, uint8_t accepted) {
+    gate_stats[gate].accepted += accepted;
+    gate_stats[gate].processed += processed;
+    gate_processed_us = trace_now();
+}
+
 // Inicializa os periféricos da placa
 void peripheral_initialization() {
     // Inicialização dos botões
@@ -152,9 +487,7 @@ void peripheral_initialization() {
     btn_setup(BTN_SW_PIN);
 
     // Adiciona a interrupção para os botões
-    gpio_set_irq_enabled_with_callback(BTN_A_PIN, GPIO_IRQ_EDGE_FALL, true, &gpio_irq_handler);
-    gpio_set_irq_enabled(BTN_B_PIN, GPIO_IRQ_EDGE_FALL, true);
-    gpio_set_irq_enabled(BTN_SW_PIN, GPIO_IRQ_EDGE_FALL, true);
+    debounce_setup();
 
     // Inicializa os LEDs RGB
     led_rgb_setup(LED_RED);
@@ -162,251 +495,625 @@ void peripheral_initialization() {
     led_rgb_setup(LED_BLUE);
 
     // Ativa o LED azul para o contador == 0
-    gpio_put(LED_RED, 0);
-    gpio_put(LED_GREEN, 0);
-    gpio_put(LED_BLUE, 1);
-
-    // Inicializa o buzzer
-    gpio_set_function(BUZZER_PIN, GPIO_FUNC_PWM);
-    slice_num   = pwm_gpio_to_slice_num(BUZZER_PIN);
-    channel_num = pwm_gpio_to_channel(BUZZER_PIN);
+    hal_gpio_put(LED_RED, 0);
+    hal_gpio_put(LED_GREEN, 0);
+    hal_gpio_put(LED_BLUE, 1);
 
-    // Configuração inicial do PWM
-    pwm_config config = pwm_get_default_config();
-    pwm_init(slice_num, &config, true);
-
-    // Desliga PWM do pino ligado ao buzzer
-    pwm_set_enabled(slice_num, false);
+    // Inicializa o buzzer (PWM configurado e desligado) e o seu sequenciador
+    buzzer_init(BUZZER_PIN);
+}
 
+// Inicializa o I2C e o display e desenha a tela inicial. Executada pela tarefa do display,
+// para que a interrupção do DMA do I2C seja atendida no mesmo núcleo que ela.
+void display_setup() {
     // Inicialização do protocolo I2C com 400Khz
     i2c_setup(400);
 
     // Inicializa a estrutura do display
     ssd1306_setup(&ssd);
 
-    // Realiza a limpeza do display
-    ssd1306_fill(&ssd, false);
+    // Monta o quadro inicial completo (tela fixa pré-renderizada e contador), envia uma única
+    // vez e só então liga o display: nenhum quadro intermediário chega ao barramento
+    display_cmd_t counter = { .type = DISPLAY_CMD_COUNTER };
+    ssd1306_load(&ssd, ui_screen_main);
+    counter_layout();
+    display_apply(&counter);
     ssd1306_send_data(&ssd);
+    ssd1306_display_on(&ssd, true);
+
+    // O relatório é impresso pela tarefa do console (sem printf na pilha da tarefa do display)
+    boot_first_frame_us = hal_time_us();
+}
 
-    ssd1306_rect(&ssd, 3, 3, 122, 60, true, false);
-    ssd1306_line(&ssd, 3, 15, 123, 15, true); // linha horizontal - primeira
-    ssd1306_line(&ssd, 3, 40, 123, 40, true); // linha horizontal - segunda
-    ssd1306_line(&ssd, 53, 15, 53, 40, true); // linha vertical
-    ssd1306_draw_string(&ssd, "Estacionamento", 9, 6);
-    ssd1306_draw_string(&ssd, "Vagas", 9, 20);
-    ssd1306_draw_string(&ssd, "Disp.", 9, 30);
+// Posiciona os campos do contador e desenha as suas partes fixas (" de " e a capacidade total).
+// Os campos têm a largura da capacidade correspondente, então o layout não muda com os valores.
+void counter_layout() {
+    uint8_t digits = ui_number_digits(parking_lot.capacity);
+    ui_number_t total;
+
+    ui_number_init(&counter_free, COUNTER_X, COUNTER_Y, digits, &font_8x8, 1);
+    uint8_t x = COUNTER_X + digits * ui_number_cell_width(&counter_free);
+    x = ssd1306_draw_text(&ssd, &font_8x8, " de ", x, COUNTER_Y, 1);
+    ui_number_init(&total, x, COUNTER_Y, digits, &font_8x8, 1);
+    ui_number_set(&total, &ssd, parking_lot.capacity);
+
+    // Zonas separadas por uma célula em branco
+    uint8_t used = 0;
+    x = COUNTER_X;
+    counter_zone_fields = 0;
+    for (uint8_t z = 0; z < PARKING_ZONE_COUNT; z++) {
+        uint8_t zone_digits = ui_number_digits(parking_zones[z].capacity);
+        uint8_t gap = z ? 1 : 0;
+        if (used + gap + zone_digits > COUNTER_ZONES_MAX_CHARS) {
+            break;
+        }
 
-    ssd1306_draw_string(&ssd, "8 de 8", 64, 25);
-    ssd1306_send_data(&ssd);
+        x += gap * font_8x8.width;
+        ui_number_init(&counter_zones[z], x, COUNTER_ZONES_Y, zone_digits, &font_8x8, 1);
+        x += zone_digits * ui_number_cell_width(&counter_zones[z]);
+        used += gap + zone_digits;
+        counter_zone_fields++;
+    }
+}
+
+// Imprime os tempos do boot até o escalonador e até o primeiro quadro
+void boot_report() {
+    printf("Boot: escalonador em %lu.%03lu ms, primeiro quadro em %lu.%03lu ms\n",
+           (unsigned long)(boot_scheduler_us / 1000), (unsigned long)(boot_scheduler_us % 1000),
+           (unsigned long)(boot_first_frame_us / 1000), (unsigned long)(boot_first_frame_us % 1000));
+}
+
+// Imprime os contadores de descartes (comandos do display, eventos dos portões, sons do buzzer e
+// eventos do registro)
+void drops_report() {
+    printf("Descartes: %lu comando(s) do display, %lu evento(s) dos portoes, %lu som(ns) do buzzer, "
+           "%lu evento(s) do registro\n", (unsigned long)display_dropped_cmds, (unsigned long)gate_event_overflows,
+           (unsigned long)buzzer_dropped(), (unsigned long)parking_log.dropped);
 }
 
 // Realiza a inicialização dos botões
 void btn_setup(uint gpio) {
-  gpio_init(gpio);
-  gpio_set_dir(gpio, GPIO_IN);
-  gpio_pull_up(gpio);
+  hal_gpio_input_pullup(gpio);
 }
 
 // Realiza a inicialização dos LEDs RGB
 void led_rgb_setup(uint gpio) {
-  gpio_init(gpio);
-  gpio_set_dir(gpio, GPIO_OUT);
+  hal_gpio_output(gpio);
 }
 
 // Realiza a inicialização do protocolo I2C para comunicação com o display OLED
 void i2c_setup(uint baud_in_kilo) {
-  i2c_init(I2C_PORT, baud_in_kilo * 1000);
-
-  gpio_set_function(I2C_SDA, GPIO_FUNC_I2C);
-  gpio_set_function(I2C_SCL, GPIO_FUNC_I2C);
-  gpio_pull_up(I2C_SDA);
-  gpio_pull_up(I2C_SCL);
+  hal_i2c_init(I2C_PORT, baud_in_kilo * 1000, I2C_SDA, I2C_SCL);
 }
 
-// Realiza a inicialização do display OLED
+// Realiza a inicialização do display OLED (configurado, ainda desligado e sem nenhum envio de dados).
+// O primeiro envio é sempre completo, então não é preciso limpar a RAM do display antes.
 void ssd1306_setup(ssd1306_t *ssd_ptr) {
   ssd1306_init(ssd_ptr, WIDTH, HEIGHT, false, SSD1306_ADDRESS, I2C_PORT); // Inicializa o display
   ssd1306_config(ssd_ptr);                                                // Configura o display
-  ssd1306_send_data(ssd_ptr);                                             // Envia os dados para o display
+}
+
+// Exibe uma mensagem temporária no display sem bloquear: a tarefa do display a apaga
+// (ou volta à mensagem anterior ainda válida) quando vencer
+void display_overlay(const char *message, uint8_t x, uint8_t y, uint16_t duration_ms) {
+    display_cmd_t cmd = { .type = DISPLAY_CMD_OVERLAY, .x = x, .y = y, .duration_ms = duration_ms };
 
-  // Limpa o display. O display inicia com todos os pixels apagados.
-  ssd1306_fill(ssd_ptr, false);
-  ssd1306_send_data(ssd_ptr);
+    strncpy(cmd.text, message, DISPLAY_TEXT_MAX - 1);
+    display_post(&cmd);
 }
 
-// Cálculo dos paramêtros do PWM para buzzer emitir frequência especificada
-void pwm_set_frequency(float frequency) {
-    // Se frequência for menor que zero não executa nada
-    if (frequency <= 0.0f) {
-        pwm_set_enabled(slice_num, false);
-        return;
+// Empilha uma mensagem temporária. Com a pilha cheia, a mais antiga é descartada.
+void overlay_push(const display_cmd_t *cmd) {
+    if (overlay_count == OVERLAY_MAX) {
+        memmove(&overlays[0], &overlays[1], (OVERLAY_MAX - 1) * sizeof(overlay_t));
+        overlay_count--;
     }
 
-    // Calcula os valores para o divisor e para o wrap
-    divider = clock / (uint32_t)(frequency * 1000);
-    wrap = clock / (divider * (uint32_t)frequency) - 1;
-
-    // Aplica as configurações calculados
-    pwm_set_clkdiv_int_frac(slice_num, divider, 0);
-    pwm_set_wrap(slice_num, wrap);
-    pwm_set_chan_level(slice_num, channel_num, wrap / 2); // Define o Duty cycle de 50%
+    overlay_t *overlay = &overlays[overlay_count++];
+    memcpy(overlay->text, cmd->text, DISPLAY_TEXT_MAX);
+    overlay->x = cmd->x;
+    overlay->y = cmd->y;
+    overlay->expires = xTaskGetTickCount() + pdMS_TO_TICKS(cmd->duration_ms);
 }
 
-// Emite o som no buzzer
-void buzzer_sound(uint beep_type) {
-    // buzzer emite um beep único com freq. de 60hz
-    if (beep_type == 0) {
-        // Define a frequência do buzzer
-        pwm_set_frequency(60);
+// Descarta as mensagens vencidas, redesenha a faixa com a mais recente e agenda o seu vencimento
+void overlay_refresh() {
+    TickType_t now = xTaskGetTickCount();
+
+    uint8_t kept = 0;
+    for (uint8_t i = 0; i < overlay_count; i++) {
+        if ((int32_t)(overlays[i].expires - now) > 0) {
+            overlays[kept++] = overlays[i];
+        }
+    }
+    overlay_count = kept;
 
-        // Liga o buzzer por 100ms
-        pwm_set_enabled(slice_num, true);
-        vTaskDelay(pdMS_TO_TICKS(100));
-        pwm_set_enabled(slice_num, false);
+    ssd1306_rect(&ssd, OVERLAY_Y, OVERLAY_X, OVERLAY_W, OVERLAY_H, false, true);
+    if (overlay_count == 0) {
+        // Se o stop falhar, o vencimento que sobrar apenas redesenha a faixa vazia
+        xTimerStop(xOverlayTimer, 0);
+        overlay_timer_lost = false;
+        return;
     }
 
-    // buzzer emite um beep duplo com freq. de 60hz
-    if (beep_type == 1) {
-        for (int i = 0; i < 2; i++) {
-            // Define a frequência do buzzer
-            pwm_set_frequency(60);
+    // Com a fila de comandos dos timers cheia, vDisplayTask chama novamente esta função a cada
+    // OVERLAY_RETRY_MS até conseguir agendar o vencimento (ou a mensagem vencer)
+    const overlay_t *top = &overlays[overlay_count - 1];
+    ssd1306_draw_string(&ssd, top->text, top->x, top->y);
+    overlay_timer_lost = xTimerChangePeriod(xOverlayTimer, top->expires - now, 0) != pdPASS;
+}
 
-            // Liga o buzzer por 100ms
-            pwm_set_enabled(slice_num, true);
-            vTaskDelay(pdMS_TO_TICKS(100));
-            pwm_set_enabled(slice_num, false);
-            vTaskDelay(pdMS_TO_TICKS(100));
-        }
+// Vencimento da mensagem exibida. Se a fila do display estiver cheia, tenta novamente em seguida
+// (o aviso não pode se perder, senão a mensagem ficaria na tela).
+void overlay_timer_callback(TimerHandle_t timer) {
+    display_cmd_t cmd = { .type = DISPLAY_CMD_OVERLAY_EXPIRE };
+    cmd.posted_us = trace_now();
+    if (xQueueSend(xDisplayQueue, &cmd, 0) != pdTRUE) {
+        xTimerChangePeriod(timer, pdMS_TO_TICKS(OVERLAY_RETRY_MS), 0);
+    }
+}
+
+// Envia um comando de desenho para a tarefa do display sem bloquear.
+// Com a fila cheia o comando é descartado e contabilizado.
+void display_post(display_cmd_t *cmd) {
+    cmd->posted_us = trace_now();
+    if (xQueueSend(xDisplayQueue, cmd, 0) != pdTRUE) {
+        display_dropped_cmds++;
     }
 }
 
-// Exibe mensagem temporária no display
-void show_message(const char *message, uint8_t x, uint8_t y, uint32_t delay_ms) {
-    xSemaphoreTake(xDisplayMutex, portMAX_DELAY);
+// Aplica um comando de desenho ao buffer do display (executada apenas por vDisplayTask)
+void display_apply(const display_cmd_t *cmd) {
+    switch (cmd->type) {
+        case DISPLAY_CMD_COUNTER:
+            // Total de vagas livres e as vagas livres de cada zona: apenas os dígitos alterados
+            // são redesenhados
+            ui_number_set(&counter_free, &ssd, parking_lot_free(&parking_lot));
+            for (uint8_t z = 0; z < counter_zone_fields; z++) {
+                ui_number_set(&counter_zones[z], &ssd, parking_zone_free(&parking_zones[z]));
+            }
+            led_rgb_update();
+            break;
+        case DISPLAY_CMD_OVERLAY:
+            overlay_push(cmd);
+            overlay_refresh();
+            break;
+        case DISPLAY_CMD_OVERLAY_EXPIRE:
+            overlay_refresh();
+            break;
+    }
+}
 
-    // Exibe a mensagem
-    ssd1306_draw_string(&ssd, message, x, y);
-    ssd1306_send_data(&ssd);
+// Envia de forma assíncrona (DMA) as alterações do display.
+// Só aguarda se um envio anterior ainda estiver em andamento.
+void display_flush(uint32_t origin_us) {
+    xSemaphoreTake(xDisplayFlushSemaphore, portMAX_DELAY);
 
-    xSemaphoreGive(xDisplayMutex);
+    display_flush_origin_us = origin_us;
+    display_flush_start_us = trace_now();
 
-    // Aguarda o tempo de exibição
-    vTaskDelay(pdMS_TO_TICKS(delay_ms));
+    // Se não houver nada a enviar, o barramento continua livre
+    if (!ssd1306_send_data_async(&ssd, display_flush_done, NULL)) {
+        display_busy = false;
+        xSemaphoreGive(xDisplayFlushSemaphore);
+    }
+}
 
-    // Apaga a área da mensagem
-    xSemaphoreTake(xDisplayMutex, portMAX_DELAY);
+// Chamada ao término do envio assíncrono do display (contexto de interrupção). As marcações
+// de TRACE_FLUSH e TRACE_TOTAL são do fim do DMA, não do barramento ocioso (lib/trace.h)
+void display_flush_done(ssd1306_t *ssd_ptr, void *ctx) {
+    uint32_t now = trace_now();
+    trace_record(TRACE_FLUSH, display_flush_start_us, now);
+    telemetry_emit(TELEMETRY_SRC_DISPLAY, TELEMETRY_LATENCY, TRACE_FLUSH, 0, now - display_flush_start_us, 0);
+    if (display_flush_origin_us != 0) {
+        trace_record(TRACE_TOTAL, display_flush_origin_us, now);
+        telemetry_emit(TELEMETRY_SRC_DISPLAY, TELEMETRY_LATENCY, TRACE_TOTAL, 0, now - display_flush_origin_us, 0);
+    }
 
-    ssd1306_rect(&ssd, 42, 5, 118, 19, true, true);
-    ssd1306_rect(&ssd, 42, 5, 118, 19, false, true);
-    ssd1306_send_data(&ssd);
+    display_busy = false;
 
-    xSemaphoreGive(xDisplayMutex);
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    xSemaphoreGiveFromISR(xDisplayFlushSemaphore, &xHigherPriorityTaskWoken);
+    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
 }
 
-// Atualiza o conteúdo do display (contador) e do LED RGB
-void update_counter_led() {
-    // Assume temporariamente o controle do display OLED
-    xSemaphoreTake(xDisplayMutex, portMAX_DELAY);
+// Número de vagas ocupadas (total mantido a cada evento)
+uint16_t parking_occupancy() {
+    return parking_lot.occupied;
+}
 
-    // Cria o buffer para texto que será carregado no display
-    char buffer[32];
+// Pede a gravação dos eventos pendentes do registro à tarefa de gravação (sem bloquear o timer)
+void event_log_timer_callback(TimerHandle_t timer) {
+    event_log_sync(&parking_log);
+}
 
-    // Atualiza o contador do display
-    ssd1306_rect(&ssd, 20, 56, 65, 18, false, false); // Limpa região do contador
-    sprintf(buffer, "%d de %d", PARKING_MAX - parking_counter, PARKING_MAX);
-    ssd1306_draw_string(&ssd, buffer, 64, 25);
-    ssd1306_send_data(&ssd);
+// Pede a atualização do contador do display e do LED RGB (os valores são lidos na renderização,
+// e só a tarefa do display escreve nos pinos do LED)
+void update_counter(uint32_t origin_us) {
+    display_cmd_t cmd = { .type = DISPLAY_CMD_COUNTER, .origin_us = origin_us };
+    display_post(&cmd);
+}
 
-    // Atualiza o LED RGB com base no valor do contador
-    if (parking_counter == 0) {
-        gpio_put(LED_RED, 0);
-        gpio_put(LED_GREEN, 0);
-        gpio_put(LED_BLUE, 1);
-    } else if (parking_counter < PARKING_MAX - 1) {
-        gpio_put(LED_RED, 0);
-        gpio_put(LED_GREEN, 1);
-        gpio_put(LED_BLUE, 0);
-    } else if (parking_counter == PARKING_MAX - 1) {
-        gpio_put(LED_RED, 1);
-        gpio_put(LED_GREEN, 1);
-        gpio_put(LED_BLUE, 0);
+// Atualiza o LED RGB com base na ocupação
+void led_rgb_update() {
+    uint16_t occupied = parking_occupancy();
+    if (occupied == 0) {
+        hal_gpio_put(LED_RED, 0);
+        hal_gpio_put(LED_GREEN, 0);
+        hal_gpio_put(LED_BLUE, 1);
+    } else if (occupied < parking_lot.capacity - 1) {
+        hal_gpio_put(LED_RED, 0);
+        hal_gpio_put(LED_GREEN, 1);
+        hal_gpio_put(LED_BLUE, 0);
+    } else if (occupied == parking_lot.capacity - 1) {
+        hal_gpio_put(LED_RED, 1);
+        hal_gpio_put(LED_GREEN, 1);
+        hal_gpio_put(LED_BLUE, 0);
     } else {
-        gpio_put(LED_RED, 1);
-        gpio_put(LED_GREEN, 0);
-        gpio_put(LED_BLUE, 0);
+        hal_gpio_put(LED_RED, 1);
+        hal_gpio_put(LED_GREEN, 0);
+        hal_gpio_put(LED_BLUE, 0);
     }
-
-    // Libera o display OLED
-    xSemaphoreGive(xDisplayMutex);
 }
 
-// Implementa a tarefa de entrada de carro (botão A)
-void vEntranceTask() {
+// Implementa a tarefa de um portão de entrada (botão A). 'params' aponta para a fila do portão
+void vEntranceTask(void *params) {
+    QueueHandle_t queue = *(QueueHandle_t *)params;
+    gate_event_t events[GATE_BATCH_MAX];
+
     while (true) {
-        // Obtém o semáforo do contador de carros
-        xSemaphoreTake(xEntranceBiSemaphore, portMAX_DELAY);
+        // Aguarda os eventos de entrada pendentes
+        uint8_t count = gate_receive_batch(queue, events, GATE_BATCH_MAX);
+        uint8_t admitted = 0;
+
+        // Admite cada carro enquanto houver vaga livre em alguma zona
+        for (uint8_t i = 0; i < count; i++) {
+            if (admission_try_enter(&admission)) {
+                admitted++;
+            }
+        }
 
-        // Verifica se o semáforo do cotandor atingiu o limite (PARKING_MAX). Caso não tenha atingido, executa o bloco abaixo
-        if (parking_counter < PARKING_MAX) {
-            // Incrementa o contador do número de carros no estacionamento
-            parking_counter = parking_counter + 1;
+        gate_stats_update(GATE_ENTRANCE, count, admitted);
 
+        if (admitted > 0) {
             // Atualiza o display OLED, o LED RGB
-            update_counter_led();
+            update_counter(events[0].timestamp_us);
 
-            show_message("Carro entrou", 9, 48, 1500);
+            printf("%d carro(s) entraram no estacionamento!\n", admitted);
+        }
 
-            printf("Carro entrou no estacionamento!\n");
-        } else {
+        if (admitted < count) {
             // Atualiza o display OLED, o LED RGB e o buzzer
-            buzzer_sound(0);
+            buzzer_play(&BEEP_SINGLE);
 
-            show_message("Vaga indisp.", 9, 48, 1500);
+            display_overlay("Vaga indisp.", 9, 48, 1500);
 
-            printf("Limite máximo de carros foi atingido!\n");
+            printf("Limite máximo de carros foi atingido! %d carro(s) recusado(s)\n", count - admitted);
+        } else {
+            display_overlay("Carro entrou", 9, 48, 1500);
         }
     }
 }
 
-// Implementa a tarefa de saída de carro (botão B)
-void vLeaveTask() {
+// Implementa a tarefa de um portão de saída (botão B). 'params' aponta para a fila do portão
+void vLeaveTask(void *params) {
+    QueueHandle_t queue = *(QueueHandle_t *)params;
+    gate_event_t events[GATE_BATCH_MAX];
+
     while (true) {
-        // Obtém o semáforo do contador de carros
-        xSemaphoreTake(xExitBiSemaphore, portMAX_DELAY);
+        // Aguarda os eventos de saída pendentes
+        uint8_t count = gate_receive_batch(queue, events, GATE_BATCH_MAX);
+        uint8_t left = 0;
+
+        // Verifica se há carros estacionados antes de decrementar o contador
+        for (uint8_t i = 0; i < count; i++) {
+            if (admission_try_leave(&admission)) {
+                left++;
+            }
+        }
+
+        gate_stats_update(GATE_EXIT, count, left);
 
-        // Verifica se o semáforo do cotandor atingiu o limite (PARKING_MAX). Caso não tenha atingido, executa o bloco abaixo
-        if (parking_counter > 0) {
-            printf("Carro saiu do estacionamento!\n");
+        if (left < count) {
+            printf("Nenhum carro estacionado!\n");
+        }
 
-            // Decrementa o contador do número de carros no estacionamento
-            parking_counter = parking_counter - 1;
+        if (left > 0) {
+            printf("%d carro(s) saíram do estacionamento!\n", left);
 
-            update_counter_led();
+            update_counter(events[0].timestamp_us);
 
-            show_message("Carro saiu", 9, 48, 1500);
-        } else {
-            printf("Nenhum carro estacionado!\n");
+            display_overlay("Carro saiu", 9, 48, 1500);
         }
     }
 }
 
 // Implementa a tarefa de resetar o sistema (botão SW - Joystick)
 void vResetTask() {
+    gate_event_t events[GATE_BATCH_MAX];
+
     while (true) {
-        // Obtém o semáforo do contador de carros
-        xSemaphoreTake(xResetBiSemaphore, portMAX_DELAY);
+        // Pedidos de reset acumulados resultam em um único reset
+        uint8_t count = gate_receive_batch(xResetQueue, events, GATE_BATCH_MAX);
 
         // Reseta o contador do sistema
-        parking_counter = 0;
+        admission_reset(&admission);
+        gate_stats_update(GATE_RESET, count, count);
+
+        // Atualiza o display OLED, o LED RGB e o buzzer
+        update_counter(events[0].timestamp_us);
 
-        show_message("Reiniciado sis", 9, 48, 2500);
+        display_overlay("Reiniciado sis", 9, 48, 2500);
 
         // Emite um beep duplo
-        buzzer_sound(1);
-
-        // Atualiza o display OLED, o LED RGB e o buzzer
-        update_counter_led();
+        buzzer_play(&BEEP_DOUBLE);
 
         printf("Sistema reiniciado!\n");
     }
 }
+
+// Implementa a tarefa dona do display: consome a fila de comandos e envia ao OLED
+void vDisplayTask() {
+    display_cmd_t cmd;
+
+    // A tarefa de timers só existe depois de o escalonador iniciar: fixa-a aqui no núcleo 1, junto
+    // da E/S lenta, já que os callbacks do sequenciador do buzzer tocam o PWM
+    task_pin(xTimerGetTimerDaemonTaskHandle(), CORE_OUTPUTS);
+    display_setup();
+
+    while (true) {
+        // Aguarda o próximo comando de desenho; sem o timer das mensagens, confere o vencimento
+        TickType_t wait = overlay_timer_lost ? pdMS_TO_TICKS(OVERLAY_RETRY_MS) : portMAX_DELAY;
+        if (xQueueReceive(xDisplayQueue, &cmd, wait) != pdTRUE) {
+            cmd = (display_cmd_t){ .type = DISPLAY_CMD_OVERLAY_EXPIRE, .posted_us = trace_now() };
+        }
+        uint32_t wake_us = trace_now();
+        display_busy = true;
+        uint32_t origin_us = 0;
+
+        // Aplica todos os comandos pendentes antes de um único envio ao display.
+        // A latência total é medida a partir da interrupção mais antiga do lote.
+        do {
+            trace_record(TRACE_DISPLAY_QUEUE, cmd.posted_us, trace_now());
+            if (cmd.origin_us != 0 && (origin_us == 0 || (int32_t)(cmd.origin_us - origin_us) < 0)) {
+                origin_us = cmd.origin_us;
+            }
+            display_apply(&cmd);
+        } while (xQueueReceive(xDisplayQueue, &cmd, 0) == pdTRUE);
+
+        trace_record(TRACE_RENDER, wake_us, trace_now());
+        display_flush(origin_us);
+    }
+}
+
+// Implementa a tarefa do console: 't' imprime as latências, o uso de CPU e os tempos do boot, 'z' zera as latências,
+// 'b' liga/desliga a telemetria binária
+void vConsoleTask() {
+    bool boot_reported = false;
+    char line[INJECT_LINE_MAX];
+    uint8_t line_len = 0;
+
+    while (true) {
+        if (!boot_reported && boot_first_frame_us != 0) {
+            boot_report();
+            boot_reported = true;
+        }
+
+        int c = hal_console_getchar();
+        if (c < 0) {
+            vTaskDelay(pdMS_TO_TICKS(CONSOLE_POLL_MS));
+            continue;
+        }
+
+        // Comandos de uma letra agem imediatamente; 'i' inicia uma linha com parâmetros
+        if (line_len > 0 || c == 'i') {
+            if (c == '\r' || c == '\n') {
+                line[line_len] = '\0';
+                inject_command(line);
+                line_len = 0;
+            } else if (line_len < INJECT_LINE_MAX - 1) {
+                line[line_len++] = c;
+            }
+        } else if (c == 't') {
+            trace_dump();
+            boot_report();
+            drops_report();
+        } else if (c == 'z') {
+            trace_reset();
+        } else if (c == 'b') {
+            telemetry_set_enabled(!telemetry_enabled());
+            printf("Telemetria binaria %s\n", telemetry_enabled() ? "ligada" : "desligada");
+        }
+    }
+}
+
+// Interpreta e executa uma linha "i <padrao> [n] [intervalo_us]": o padrão é uma sequência de
+// portões ('e' entrada, 's' saída, 'r' reset), repetida até 'n' eventos (padrão: um ciclo, sem intervalo)
+void inject_command(const char *line) {
+    char pattern[INJECT_PATTERN_MAX + 1];
+    unsigned long count = 0, interval_us = 0;
+
+    if (sscanf(line, "i %24s %lu %lu", pattern, &count, &interval_us) < 1 || pattern[strspn(pattern, "esr")] != '\0') {
+        printf("Uso: i <padrao de e/s/r> [n] [intervalo_us]\n");
+        return;
+    }
+    inject_events(pattern, count ? count : strlen(pattern), interval_us);
+}
+
+// Aguarda até o instante 'until_us': dorme enquanto faltar ao menos um tick, depois apenas cede o processador
+void inject_wait(uint32_t until_us) {
+    int32_t remaining;
+
+    while ((remaining = (int32_t)(until_us - trace_now())) > 0) {
+        TickType_t ticks = remaining / (1000 * portTICK_PERIOD_MS);
+        if (ticks > 0) {
+            vTaskDelay(ticks);
+        } else {
+            taskYIELD();
+        }
+    }
+}
+
+// Soma dos eventos tratados pelas tarefas dos portões desde 'before'
+uint32_t inject_processed(const gate_stats_t *before) {
+    uint32_t total = 0;
+    for (uint8_t g = 0; g < GATE_COUNT; g++) {
+        total += gate_stats[g].processed - before[g].processed;
+    }
+    return total;
+}
+
+// Confere a ocupação após a injeção: as zonas devem concordar com o semáforo de contagem e, sem resets,
+// com a ocupação inicial mais as entradas e menos as saídas aceitas
+void inject_check(uint16_t occupied_before, const gate_stats_t *before) {
+    uint32_t entered = gate_stats[GATE_ENTRANCE].accepted - before[GATE_ENTRANCE].accepted;
+    uint32_t left = gate_stats[GATE_EXIT].accepted - before[GATE_EXIT].accepted;
+    bool resets = gate_stats[GATE_RESET].accepted != before[GATE_RESET].accepted;
+
+    admission_lock(&admission);
+    uint16_t occupied = parking_lot.occupied;
+    bool consistent = occupied + admission_free_tokens(&admission) == parking_lot.capacity;
+    admission_unlock(&admission);
+
+    if (resets) {
+        printf("Ocupacao: %u de %u vagas, %s\n", occupied, parking_lot.capacity, consistent ? "ok" : "ERRO");
+    } else {
+        long expected = (long)occupied_before + entered - left;
+        printf("Ocupacao: %u de %u vagas (esperado %ld), %s\n", occupied, parking_lot.capacity, expected,
+               consistent && expected == occupied ? "ok" : "ERRO");
+    }
+}
+
+// Entrega os eventos pelo mesmo caminho da interrupção (fila do portão, sem bloquear), sem o
+// debounce. Eventos recusados por fila cheia são contados como descartados.
+void inject_events(const char *pattern, uint32_t count, uint32_t interval_us) {
+    gate_stats_t before[GATE_COUNT];
+    for (uint8_t g = 0; g < GATE_COUNT; g++) {
+        before[g].processed = gate_stats[g].processed;
+        before[g].accepted = gate_stats[g].accepted;
+    }
+    uint16_t occupied_before = parking_lot.occupied;
+    size_t pattern_len = strlen(pattern);
+    uint32_t sent = 0, dropped = 0;
+    uint32_t start_us = trace_now(), next_us = start_us;
+
+    for (uint32_t i = 0; i < count; i++) {
+        char kind = pattern[i % pattern_len];
+        uint8_t gate = kind == 'e' ? GATE_ENTRANCE : kind == 's' ? GATE_EXIT : GATE_RESET;
+        gate_event_t event = { .timestamp_us = trace_now(), .gate = gate, .edge = 0, .display_busy = display_busy };
+
+        if (xQueueSendToBack(*gate_queues[gate], &event, 0) == pdTRUE) {
+            sent++;
+        } else {
+            dropped++;
+        }
+        telemetry_emit(TELEMETRY_SRC_CONSOLE, TELEMETRY_GATE_EVENT, gate, event.display_busy << 8, 0, 0);
+
+        next_us += interval_us;
+        inject_wait(next_us);
+    }
+    uint32_t offer_us = trace_now() - start_us;
+
+    // Aguarda as tarefas dos portões tratarem os eventos entregues
+    TickType_t deadline = xTaskGetTickCount() + pdMS_TO_TICKS(INJECT_DRAIN_TIMEOUT_MS);
+    while (inject_processed(before) < sent && (int32_t)(deadline - xTaskGetTickCount()) > 0) {
+        vTaskDelay(1);
+    }
+
+    uint32_t processed = inject_processed(before), accepted = 0;
+    for (uint8_t g = 0; g < GATE_COUNT; g++) {
+        accepted += gate_stats[g].accepted - before[g].accepted;
+    }
+    uint32_t elapsed_us = processed > 0 ? gate_processed_us - start_us : 0;
+
+    printf("Injecao: %lu enviado(s), %lu descartado(s) (fila cheia), %lu aceito(s), %lu recusado(s)\n",
+           (unsigned long)sent, (unsigned long)dropped, (unsigned long)accepted, (unsigned long)(processed - accepted));
+    printf("Oferta: %lu eventos/s em %lu us; tratados: %lu eventos/s em %lu us\n",
+           (unsigned long)(offer_us ? (uint64_t)count * 1000000 / offer_us : 0), (unsigned long)offer_us,
+           (unsigned long)(elapsed_us ? (uint64_t)processed * 1000000 / elapsed_us : 0), (unsigned long)elapsed_us);
+    if (processed < sent) {
+        printf("Tempo esgotado: %lu evento(s) ainda nao tratado(s)\n", (unsigned long)(sent - processed));
+    }
+    inject_check(occupied_before, before);
+}
+
+// Implementa a tarefa de telemetria: esvazia os anéis em quadros e gera as amostras periódicas
+void vTelemetryTask() {
+    TickType_t last_sample = xTaskGetTickCount();
+
+    while (true) {
+        vTaskDelay(pdMS_TO_TICKS(TELEMETRY_PERIOD_MS));
+        if (!telemetry_enabled()) {
+            continue;
+        }
+
+        if (xTaskGetTickCount() - last_sample >= pdMS_TO_TICKS(TELEMETRY_SAMPLE_MS)) {
+            last_sample = xTaskGetTickCount();
+            telemetry_sample();
+        }
+        telemetry_drain();
+    }
+}
+
+// Menor prioridade, como as demais tarefas: apagar um setor leva dezenas de ms, em que as
+// outras tarefas seguem sendo escalonadas, e nenhum mutex das zonas fica retido durante a gravação
+void vEventLogTask() {
+    while (true) {
+        event_log_process(&parking_log, portMAX_DELAY);
+    }
+}
+
+// Registra a ocupação de cada zona, o uso de CPU/pilha das tarefas e os contadores de perdas
+void telemetry_sample() {
+    for (uint8_t z = 0; z < PARKING_ZONE_COUNT; z++) {
+        telemetry_emit(TELEMETRY_SRC_SYSTEM, TELEMETRY_OCCUPANCY, z, parking_zones[z].occupied,
+                       parking_zones[z].capacity, 0);
+    }
+
+#if configGENERATE_RUN_TIME_STATS
+    static TaskStatus_t tasks[TRACE_MAX_TASKS];
+    configRUN_TIME_COUNTER_TYPE total;
+    UBaseType_t count = uxTaskGetSystemState(tasks, TRACE_MAX_TASKS, &total);
+    for (UBaseType_t t = 0; t < count; t++) {
+        telemetry_emit(TELEMETRY_SRC_SYSTEM, TELEMETRY_TASK_STATS, tasks[t].xTaskNumber, 0,
+                       (uint32_t)tasks[t].ulRunTimeCounter, tasks[t].usStackHighWaterMark);
+    }
+#endif
+
+    telemetry_emit(TELEMETRY_SRC_SYSTEM, TELEMETRY_STATUS, 0, display_dropped_cmds, telemetry_dropped(),
+                   gate_event_overflows);
+}
+
+// Fixa a tarefa nos núcleos indicados (apenas no modo SMP)
+void task_pin(TaskHandle_t task, UBaseType_t core_mask) {
+#if configNUMBER_OF_CORES > 1 && configUSE_CORE_AFFINITY
+    vTaskCoreAffinitySet(task, core_mask);
+#else
+    (void)task;
+    (void)core_mask;
+#endif
+}
+
+// Memória da tarefa ociosa (exigida pelo kernel com configSUPPORT_STATIC_ALLOCATION)
+void vApplicationGetIdleTaskMemory(StaticTask_t **tcb, StackType_t **stack, configSTACK_DEPTH_TYPE *depth) {
+    *tcb = &idle_tcb[0];
+    *stack = idle_stack[0];
+    *depth = configMINIMAL_STACK_SIZE;
+}
+
+#if configNUMBER_OF_CORES > 1
+// Memória das tarefas ociosas dos demais núcleos (modo SMP)
+void vApplicationGetPassiveIdleTaskMemory(StaticTask_t **tcb, StackType_t **stack, configSTACK_DEPTH_TYPE *depth,
+                                          BaseType_t index) {
+    *tcb = &idle_tcb[index + 1];
+    *stack = idle_stack[index + 1];
+    *depth = configMINIMAL_STACK_SIZE;
+}
+#endif
+
+// Memória da tarefa de serviço dos timers
+void vApplicationGetTimerTaskMemory(StaticTask_t **tcb, StackType_t **stack, configSTACK_DEPTH_TYPE *depth) {
+    *tcb = &timer_task_tcb;
+    *stack = timer_task_stack;
+    *depth = configTIMER_TASK_STACK_DEPTH;
+}